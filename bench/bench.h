@@ -0,0 +1,75 @@
+/*! @file	bench.h
+ *  @brief	benchmark 프로그램들이 함께 쓰는 측정 함수가 정의되어있다.
+ *  @note	시간 측정, page cache 비우기, 측정용 파일 생성을 제공한다.
+ *  @see	Makefile
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+static inline double bench_now (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// root 로 실행하면 측정 전에 page cache 를 비운다. 아니면 cache 에 있는 상태로 측정된다.
+static inline bool bench_drop_caches (void)
+{
+    sync ();
+
+    int fd = open ("/proc/sys/vm/drop_caches", O_WRONLY);
+    if ( fd == -1 )
+    {
+        return false;
+    }
+
+    bool ret = write (fd, "3", 1) == 1;
+    close (fd);
+    return ret;
+}
+
+// size byte 의 임의 데이터 파일을 만든다.
+static inline bool bench_make_file (const char * path, long long size)
+{
+    static char buff[1024 * 1024];
+    FILE      * out = fopen (path, "wb");
+
+    if ( out == NULL)
+    {
+        perror (path);
+        return false;
+    }
+
+    for (size_t i = 0; i < sizeof (buff); i++)
+    {
+        buff[i] = (char)(rand () & 0xff);
+    }
+
+    for (long long left = size; left > 0;)
+    {
+        size_t n = (left < (long long)sizeof (buff)) ? (size_t)left : sizeof (buff);
+
+        if ( fwrite (buff, 1, n, out) != n )
+        {
+            perror (path);
+            fclose (out);
+            return false;
+        }
+        left -= n;
+    }
+    return fclose (out) == 0;
+}
+
+#endif //BENCH_H
@@ -0,0 +1,191 @@
+/*! @file	bench_batch.c
+ *  @brief	작은 파일 여러 개를 runFileBatch() 로 처리할 때와 하나씩 처리할 때의 속도를 비교한다.
+ *  @note	사용법 : bench_batch [작업 directory] [파일 수] [파일 크기(byte)] [thread 수] \n
+ *  		기본값은 4 KB 파일 10,000 개이며 thread 수를 주지 않으면 CPU core 수를 사용한다. \n
+ *  		copy / move / delete 를 각각 copyFile() / moveFile() / deleteFile() 반복과 runFileBatch() 로 측정한다. \n
+ *  		copy 는 fsync 하지 않는 경우와 하는 경우 (sync) 를 모두 측정한다.
+ *  @see	bench.h
+ */
+
+#include "Device/File.h"
+#include "bench.h"
+
+#include <sys/stat.h>
+
+typedef struct _BenchFiles
+{
+    int      count;
+    String * src;   // dir/src/N
+    String * dst;   // dir/dst/N
+    String * moved; // dir/moved/N
+
+} BenchFiles;
+
+static String bench_path (const char * dir, const char * sub, int index)
+{
+    String path = (String)malloc (strlen (dir) + strlen (sub) + 16);
+
+    sprintf (path, "%s/%s/%d", dir, sub, index);
+    return path;
+}
+
+// 이전 실행에서 남은 directory 를 지우고 create 이면 새로 만든다.
+static void make_dirs (const char * dir, bool create)
+{
+    char path[PATH_MAX + 16];
+    char command[PATH_MAX * 3 + 64];
+
+    snprintf (command, sizeof (command), "rm -rf '%s/src' '%s/dst' '%s/moved'", dir, dir, dir);
+    if ( system (command) != 0 )
+    {
+        fprintf (stderr, "can not clean %s\n", dir);
+    }
+    if ( create == false )
+    {
+        return;
+    }
+
+    snprintf (path, sizeof (path), "%s/src", dir);
+    mkdir (path, 0755);
+    snprintf (path, sizeof (path), "%s/dst", dir);
+    mkdir (path, 0755);
+    snprintf (path, sizeof (path), "%s/moved", dir);
+    mkdir (path, 0755);
+}
+
+static void clear_dir (const char * dir, const char * sub)
+{
+    char command[PATH_MAX * 2 + 64];
+
+    snprintf (command, sizeof (command), "find '%s/%s' -mindepth 1 -delete", dir, sub);
+    if ( system (command) != 0 )
+    {
+        fprintf (stderr, "can not clean %s/%s\n", dir, sub);
+    }
+}
+
+static void report (const char * name, double loop, double batch, int failed)
+{
+    printf ("%-12s %10.3f %10.3f %7.2fx %s\n", name, loop, batch, loop / batch, failed ? "(실패 항목 있음)" : "");
+}
+
+static int run_batch (BenchFiles * files, file_operation_e type, String * src, String * dst, int threads, bool sync, double * elapsed)
+{
+    FileOperation * operations = (FileOperation *)calloc (files->count, sizeof (FileOperation));
+    int             failed     = 0;
+
+    for (int i = 0; i < files->count; i++)
+    {
+        operations[i].type = type;
+        operations[i].src  = src[i];
+        operations[i].dst  = (dst != NULL) ? dst[i] : NULL;
+    }
+
+    bench_drop_caches ();
+    double start = bench_now ();
+    runFileBatch (operations, files->count, threads, sync);
+    *elapsed = bench_now () - start;
+
+    for (int i = 0; i < files->count; i++)
+    {
+        failed += (operations[i].result != 0);
+    }
+    free (operations);
+    return failed;
+}
+
+int main (int argc, char ** argv)
+{
+    const char * dir     = (argc > 1) ? argv[1] : ".";
+    BenchFiles   files   = {(argc > 2) ? atoi (argv[2]) : 10000, NULL, NULL, NULL};
+    long long    size    = (argc > 3) ? atoll (argv[3]) : 4096;
+    int          threads = (argc > 4) ? atoi (argv[4]) : 0;
+    double       loop, batch, start;
+    int          failed;
+
+    make_dirs (dir, true);
+    files.src   = (String *)malloc (sizeof (String) * files.count);
+    files.dst   = (String *)malloc (sizeof (String) * files.count);
+    files.moved = (String *)malloc (sizeof (String) * files.count);
+
+    printf ("%d 개의 %lld byte 파일 생성 중\n", files.count, size);
+    for (int i = 0; i < files.count; i++)
+    {
+        files.src[i]   = bench_path (dir, "src", i);
+        files.dst[i]   = bench_path (dir, "dst", i);
+        files.moved[i] = bench_path (dir, "moved", i);
+        if ( bench_make_file (files.src[i], size) == false )
+        {
+            return 1;
+        }
+    }
+
+    printf ("%-12s %10s %10s %8s\n", "operation", "loop(s)", "batch(s)", "speedup");
+
+    // copy
+    bench_drop_caches ();
+    start = bench_now ();
+    for (int i = 0; i < files.count; i++)
+    {
+        copyFile (files.src[i], files.dst[i]);
+    }
+    loop = bench_now () - start;
+    clear_dir (dir, "dst");
+    failed = run_batch (&files, FILE_OPERATION_COPY, files.src, files.dst, threads, false, &batch);
+    report ("copy", loop, batch, failed);
+
+    // copy + fsync : copyFile 은 fsync 하지 않으므로 같은 조건이 되도록 파일마다 fsync 한다.
+    clear_dir (dir, "dst");
+    bench_drop_caches ();
+    start = bench_now ();
+    for (int i = 0; i < files.count; i++)
+    {
+        copyFile (files.src[i], files.dst[i]);
+
+        int fd = open (files.dst[i], O_RDONLY);
+        if ( fd != -1 )
+        {
+            fsync (fd);
+            close (fd);
+        }
+    }
+    loop = bench_now () - start;
+    clear_dir (dir, "dst");
+    failed = run_batch (&files, FILE_OPERATION_COPY, files.src, files.dst, threads, true, &batch);
+    report ("copy sync", loop, batch, failed);
+
+    // move : dst -> moved 를 하나씩, 다시 moved -> dst 를 batch 로
+    bench_drop_caches ();
+    start = bench_now ();
+    for (int i = 0; i < files.count; i++)
+    {
+        moveFile (files.dst[i], files.moved[i]);
+    }
+    loop = bench_now () - start;
+    failed = run_batch (&files, FILE_OPERATION_MOVE, files.moved, files.dst, threads, false, &batch);
+    report ("move", loop, batch, failed);
+
+    // delete : dst 를 하나씩, 다시 복사해 둔 파일을 batch 로
+    bench_drop_caches ();
+    start = bench_now ();
+    for (int i = 0; i < files.count; i++)
+    {
+        deleteFile (files.dst[i]);
+    }
+    loop = bench_now () - start;
+    run_batch (&files, FILE_OPERATION_COPY, files.src, files.dst, threads, false, &batch);
+    failed = run_batch (&files, FILE_OPERATION_DELETE, files.dst, NULL, threads, false, &batch);
+    report ("delete", loop, batch, failed);
+
+    for (int i = 0; i < files.count; i++)
+    {
+        free (files.src[i]);
+        free (files.dst[i]);
+        free (files.moved[i]);
+    }
+    free (files.src);
+    free (files.dst);
+    free (files.moved);
+    make_dirs (dir, false);
+    return 0;
+}
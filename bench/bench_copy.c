@@ -0,0 +1,112 @@
+/*! @file	bench_copy.c
+ *  @brief	copyFile() 과 이전의 stdio 복사 속도를 비교한다.
+ *  @note	사용법 : bench_copy [작업 directory] [크기(MB) ...] \n
+ *  		크기를 주지 않으면 1 MB, 100 MB, 2048 MB 파일로 측정한다. \n
+ *  		같은 크기의 파일을 각 방식으로 세번씩 복사하여 가장 빠른 결과를 출력한다.
+ *  @see	bench.h
+ */
+
+#include "Device/File.h"
+#include "bench.h"
+
+#define BENCH_REPEAT 3
+
+// copyFile 이 copy_file_range 로 바뀌기 전의 방식 (BUFSIZ buffer 로 fread / fwrite)
+static bool stdio_copy (const char * src, const char * dst)
+{
+    char   buff[BUFSIZ];
+    FILE * in  = fopen (src, "rb");
+    FILE * out = fopen (dst, "wb");
+    size_t n;
+    bool   ret = (in != NULL && out != NULL);
+
+    while (ret && (n = fread (buff, 1, BUFSIZ, in)) != 0)
+    {
+        ret = fwrite (buff, 1, n, out) == n;
+    }
+
+    if ( in != NULL)
+    {
+        fclose (in);
+    }
+    if ( out != NULL && fclose (out) != 0 )
+    {
+        ret = false;
+    }
+    return ret;
+}
+
+static bool dit_copy (const char * src, const char * dst)
+{
+    return copyFile ((String)src, (String)dst);
+}
+
+static double measure (bool (* copy) (const char *, const char *), const char * src, const char * dst)
+{
+    double best = -1;
+
+    for (int i = 0; i < BENCH_REPEAT; i++)
+    {
+        remove (dst);
+        bench_drop_caches ();
+
+        double start = bench_now ();
+        if ( copy (src, dst) == false )
+        {
+            fprintf (stderr, "copy failed : %s\n", dst);
+            return -1;
+        }
+        double elapsed = bench_now () - start;
+
+        if ( best < 0 || elapsed < best )
+        {
+            best = elapsed;
+        }
+    }
+    remove (dst);
+    return best;
+}
+
+int main (int argc, char ** argv)
+{
+    const char * dir       = (argc > 1) ? argv[1] : ".";
+    long long    sizes[16] = {1, 100, 2048};
+    int          count     = 3;
+    char         src[PATH_MAX];
+    char         dst[PATH_MAX];
+
+    if ( argc > 2 )
+    {
+        for (count = 0; count + 2 < argc && count < 16; count++)
+        {
+            sizes[count] = atoll (argv[count + 2]);
+        }
+    }
+
+    snprintf (src, sizeof (src), "%s/bench_copy.src", dir);
+    snprintf (dst, sizeof (dst), "%s/bench_copy.dst", dir);
+
+    if ( bench_drop_caches () == false )
+    {
+        printf ("page cache 를 비울 수 없어 cache 에 있는 상태로 측정한다.\n");
+    }
+    printf ("%10s %14s %14s %8s\n", "size(MB)", "stdio(MB/s)", "copyFile(MB/s)", "speedup");
+
+    for (int i = 0; i < count; i++)
+    {
+        if ( bench_make_file (src, sizes[i] << 20) == false )
+        {
+            return 1;
+        }
+
+        double old = measure (stdio_copy, src, dst);
+        double now = measure (dit_copy, src, dst);
+
+        if ( old > 0 && now > 0 )
+        {
+            printf ("%10lld %14.1f %14.1f %7.2fx\n", sizes[i], sizes[i] / old, sizes[i] / now, old / now);
+        }
+        remove (src);
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+/*! @file	bench_parallel_copy.c
+ *  @brief	copyFileParallel() 의 worker 수에 따른 처리량을 측정한다.
+ *  @note	사용법 : bench_parallel_copy [작업 directory] [크기(MB)] [조각 크기(MB)] [최대 thread 수] \n
+ *  		기본값은 4096 MB 파일, 8 MB 조각이며 thread 수를 주지 않으면 CPU core 수까지 측정한다. \n
+ *  		copyFileParallel() 은 마지막에 fsync 하므로 기준인 copyFile() 도 복사 후 fsync 한 시간으로 비교한다.
+ *  @see	bench.h
+ */
+
+#include "Device/File.h"
+#include "bench.h"
+
+#define BENCH_REPEAT 3
+
+static bool serial_copy (const char * src, const char * dst, int threads, long long chunk)
+{
+    if ( copyFile ((String)src, (String)dst) == false )
+    {
+        return false;
+    }
+
+    int  fd  = open (dst, O_RDONLY);
+    bool ret = (fd != -1 && fsync (fd) == 0);
+
+    if ( fd != -1 )
+    {
+        close (fd);
+    }
+    return ret;
+}
+
+static bool parallel_copy (const char * src, const char * dst, int threads, long long chunk)
+{
+    return copyFileParallel ((String)src, (String)dst, threads, chunk);
+}
+
+static double measure (bool (* copy) (const char *, const char *, int, long long), const char * src, const char * dst, int threads, long long chunk)
+{
+    double best = -1;
+
+    for (int i = 0; i < BENCH_REPEAT; i++)
+    {
+        remove (dst);
+        bench_drop_caches ();
+
+        double start = bench_now ();
+        if ( copy (src, dst, threads, chunk) == false )
+        {
+            fprintf (stderr, "copy failed : %s\n", dst);
+            return -1;
+        }
+        double elapsed = bench_now () - start;
+
+        if ( best < 0 || elapsed < best )
+        {
+            best = elapsed;
+        }
+    }
+    remove (dst);
+    return best;
+}
+
+int main (int argc, char ** argv)
+{
+    const char * dir        = (argc > 1) ? argv[1] : ".";
+    long long    size       = (argc > 2) ? atoll (argv[2]) : 4096;
+    long long    chunk      = (argc > 3) ? atoll (argv[3]) << 20 : 0;
+    int          maxThreads = (argc > 4) ? atoi (argv[4]) : (int)sysconf (_SC_NPROCESSORS_ONLN);
+    char         src[PATH_MAX];
+    char         dst[PATH_MAX];
+
+    snprintf (src, sizeof (src), "%s/bench_parallel_copy.src", dir);
+    snprintf (dst, sizeof (dst), "%s/bench_parallel_copy.dst", dir);
+
+    if ( bench_make_file (src, size << 20) == false )
+    {
+        return 1;
+    }
+    if ( bench_drop_caches () == false )
+    {
+        printf ("page cache 를 비울 수 없어 cache 에 있는 상태로 측정한다.\n");
+    }
+
+    printf ("%-10s %10s %10s %8s\n", "threads", "time(s)", "MB/s", "speedup");
+
+    double serial = measure (serial_copy, src, dst, 1, chunk);
+    if ( serial > 0 )
+    {
+        printf ("%-10s %10.3f %10.1f %8s\n", "copyFile", serial, size / serial, "-");
+    }
+
+    double base = -1;
+    for (int threads = 1; threads <= maxThreads; threads = (threads * 2 > maxThreads && threads < maxThreads) ? maxThreads : threads * 2)
+    {
+        double elapsed = measure (parallel_copy, src, dst, threads, chunk);
+        if ( elapsed <= 0 )
+        {
+            break;
+        }
+        if ( base < 0 )
+        {
+            base = elapsed;
+        }
+        printf ("%-10d %10.3f %10.1f %7.2fx\n", threads, elapsed, size / elapsed, base / elapsed);
+    }
+
+    remove (src);
+    return 0;
+}
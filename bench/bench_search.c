@@ -0,0 +1,225 @@
+/*! @file	bench_search.c
+ *  @brief	searchFileParallel() 의 thread 수에 따른 속도를 측정한다.
+ *  @note	사용법 : bench_search [작업 directory] [항목 수] [최대 thread 수] \n
+ *  		항목 수를 주지 않으면 약 1,000,000 개의 파일 / directory 로 된 tree 를 만들어 측정한다. \n
+ *  		만든 tree 는 작업 directory 에 남겨 두고 같은 항목 수로 다시 실행하면 그대로 사용한다. \n
+ *  		기준으로 chdir / lstat 을 사용하던 이전의 단일 thread 검색도 함께 측정한다.
+ *  @see	bench.h
+ */
+
+#include "Device/File.h"
+#include "bench.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#define BENCH_TARGET   "bench_target"
+#define BENCH_LEAF     100  // leaf directory 하나에 만드는 파일 수
+#define BENCH_REPEAT   3
+
+// searchFile 이 병렬화되기 전의 방식 (chdir 로 이동하며 모든 항목을 lstat)
+static void old_search_recur (const char * src, const char * dest, GList ** searchList)
+{
+    DIR           * dp;
+    struct dirent * entry;
+    struct stat     statbuf;
+
+    if ((dp = opendir (src)) == NULL)
+    {
+        return;
+    }
+    if ( chdir (src) == -1 )
+    {
+        closedir (dp);
+        return;
+    }
+
+    while ((entry = readdir (dp)) != NULL)
+    {
+        if ( lstat (entry->d_name, &statbuf) == -1 )
+        {
+            continue;
+        }
+        if ( S_ISDIR (statbuf.st_mode))
+        {
+            if ( strcmp (".", entry->d_name) == 0 || strcmp ("..", entry->d_name) == 0 )
+            {
+                continue;
+            }
+            if ( strcmp (entry->d_name, dest) == 0 )
+            {
+                *searchList = g_list_prepend (*searchList, realpath (entry->d_name, NULL));
+            }
+            old_search_recur (entry->d_name, dest, searchList);
+        }
+        else if ( strcmp (entry->d_name, dest) == 0 )
+        {
+            *searchList = g_list_prepend (*searchList, realpath (entry->d_name, NULL));
+        }
+    }
+
+    if ( chdir ("..") == -1 )
+    {
+        perror ("chdir");
+    }
+    closedir (dp);
+}
+
+static GList * old_search (const char * src, const char * dest)
+{
+    char    cwd[PATH_MAX];
+    GList * list = NULL;
+
+    if ( getcwd (cwd, sizeof (cwd)) == NULL)
+    {
+        return NULL;
+    }
+    old_search_recur (src, dest, &list);
+    if ( chdir (cwd) == -1 )
+    {
+        perror ("chdir");
+    }
+    return list;
+}
+
+static bool touch (const char * path)
+{
+    int fd = open (path, O_WRONLY | O_CREAT, 0644);
+
+    if ( fd == -1 )
+    {
+        perror (path);
+        return false;
+    }
+    close (fd);
+    return true;
+}
+
+// root/dNNN/dNNN/fNNN 형태로 entries 개 정도의 항목을 만든다. 1000 번째 leaf 마다 BENCH_TARGET 을 하나 둔다.
+static bool make_tree (const char * root, long entries)
+{
+    char path[PATH_MAX + 64];
+    long leaves = (entries + BENCH_LEAF) / (BENCH_LEAF + 1);
+    long fanout = 1;
+
+    while (fanout * fanout < leaves)
+    {
+        fanout++;
+    }
+
+    snprintf (path, sizeof (path), "%s/.entries", root);
+    FILE * marker = fopen (path, "r");
+    if ( marker != NULL)
+    {
+        long made = 0;
+        bool same = fscanf (marker, "%ld", &made) == 1 && made == entries;
+
+        fclose (marker);
+        if ( same )
+        {
+            return true;
+        }
+        fprintf (stderr, "%s 에 다른 크기의 tree 가 있다. 지운 후 다시 실행한다.\n", root);
+        return false;
+    }
+
+    printf ("tree 생성 중 : %ld leaf directory x %d 파일\n", leaves, BENCH_LEAF);
+    mkdir (root, 0755);
+    for (long leaf = 0; leaf < leaves; leaf++)
+    {
+        snprintf (path, sizeof (path), "%s/d%ld", root, leaf / fanout);
+        mkdir (path, 0755);
+        snprintf (path, sizeof (path), "%s/d%ld/d%ld", root, leaf / fanout, leaf % fanout);
+        if ( mkdir (path, 0755) == -1 )
+        {
+            perror (path);
+            return false;
+        }
+
+        size_t len = strlen (path);
+
+        for (int i = 0; i < BENCH_LEAF; i++)
+        {
+            if ( i == 0 && leaf % 1000 == 0 )
+            {
+                snprintf (path + len, sizeof (path) - len, "/%s", BENCH_TARGET);
+            }
+            else
+            {
+                snprintf (path + len, sizeof (path) - len, "/f%d", i);
+            }
+            if ( touch (path) == false )
+            {
+                return false;
+            }
+        }
+    }
+
+    snprintf (path, sizeof (path), "%s/.entries", root);
+    marker = fopen (path, "w");
+    if ( marker != NULL)
+    {
+        fprintf (marker, "%ld\n", entries);
+        fclose (marker);
+    }
+    return true;
+}
+
+// cold : page cache 를 비운 직후 한번, warm : 이어서 BENCH_REPEAT 번 중 가장 빠른 시간
+static void measure (const char * root, int threads, double * cold, double * warm, int * found)
+{
+    *cold = -1;
+    *warm = -1;
+
+    bool dropped = bench_drop_caches ();
+
+    for (int i = 0; i <= BENCH_REPEAT; i++)
+    {
+        double  start   = bench_now ();
+        GList * list    = (threads == 0) ? old_search (root, BENCH_TARGET) : searchFileParallel ((String)root, BENCH_TARGET, threads);
+        double  elapsed = bench_now () - start;
+
+        *found = g_list_length (list);
+        deleteSearchedList (list);
+
+        if ( i == 0 )
+        {
+            *cold = dropped ? elapsed : -1;
+        }
+        else if ( *warm < 0 || elapsed < *warm )
+        {
+            *warm = elapsed;
+        }
+    }
+}
+
+int main (int argc, char ** argv)
+{
+    const char * dir        = (argc > 1) ? argv[1] : ".";
+    long         entries    = (argc > 2) ? atol (argv[2]) : 1000000;
+    int          maxThreads = (argc > 3) ? atoi (argv[3]) : (int)sysconf (_SC_NPROCESSORS_ONLN);
+    char         root[PATH_MAX];
+    double       cold, warm, base;
+    int          found;
+
+    snprintf (root, sizeof (root), "%s/bench_search.tree", dir);
+    if ( make_tree (root, entries) == false )
+    {
+        return 1;
+    }
+
+    printf ("%-10s %10s %10s %8s %6s\n", "threads", "cold(s)", "warm(s)", "speedup", "found");
+
+    measure (root, 0, &cold, &warm, &found);
+    printf ("%-10s %10.3f %10.3f %8s %6d\n", "old", cold, warm, "-", found);
+
+    measure (root, 1, &cold, &base, &found);
+    printf ("%-10d %10.3f %10.3f %7.2fx %6d\n", 1, cold, base, 1.0, found);
+
+    for (int threads = 2; threads <= maxThreads; threads = (threads * 2 > maxThreads && threads < maxThreads) ? maxThreads : threads * 2)
+    {
+        measure (root, threads, &cold, &warm, &found);
+        printf ("%-10d %10.3f %10.3f %7.2fx %6d\n", threads, cold, warm, base / warm, found);
+    }
+    return 0;
+}
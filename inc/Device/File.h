@@ -9,6 +9,8 @@
 
 #include <stdbool.h>
 #include <stdalign.h>
+#include <stdint.h>
+#include <time.h>
 
 #include "dit.h"
 
@@ -95,7 +97,240 @@ const char * MetadataExtractorErrorCheck (int ret);
  */
 const char * MediaContentErrorCheck (int ret);
 
+/* SearchMatcher */
+/*! @enum   search_type_e
+ *  @brief  SearchMatcher 로 검색할 파일의 종류이다.
+ */
+typedef enum
+{
+    SEARCH_TYPE_ANY = 0,    /**< 모든 종류 */
+    SEARCH_TYPE_FILE,       /**< 일반 파일 */
+    SEARCH_TYPE_DIRECTORY,  /**< 디렉토리 */
+    SEARCH_TYPE_LINK        /**< symbolic link */
+
+} search_type_e;
+
+/*! @struct	_SearchMatcher
+ *  @brief	파일 검색 조건에 대한 구조체이다. glob / 정규식 이름 조건과 크기 / 수정 시간 / 종류 조건을 가질 수 있다.
+ *  @note	File의 SearchMatcher 모듈에 대한 구조체이다. \n
+    		구조체를 사용하기 전에 NewSearchMatcher() 함수를 사용해야 하며 사용이 끝났을 때 DestroySearchMatcher() 함수를 꼭 사용해야 한다. \n
+    		이름 조건은 추가될 때 한번만 compile 되며 여러 이름 조건 중 하나라도 일치하면 이름 조건을 만족한다. \n
+    		이름 조건과 나머지 조건들은 모두 만족해야 검색 결과에 포함된다.
+ *  @see	searchFileMatch \n
+ *  		searchFileMatchForeach
+ */
+typedef struct _SearchMatcher * SearchMatcher;
+struct _SearchMatcher
+{
+    bool (* addGlob) (SearchMatcher this_gen, String pattern);
+
+    bool (* addRegex) (SearchMatcher this_gen, String pattern);
+
+    bool (* setSize) (SearchMatcher this_gen, long long minSize, long long maxSize);
+
+    bool (* setModifiedTime) (SearchMatcher this_gen, time_t after, time_t before);
+
+    bool (* setType) (SearchMatcher this_gen, search_type_e type);
+};
+
+typedef struct _SearchMatcherExtends
+{
+    struct _SearchMatcher matcher;
+    GList               * patterns;
+    search_type_e         type;
+    long long             minSize;
+    long long             maxSize;
+    time_t                after;
+    time_t                before;
+
+} SearchMatcherExtends;
+
+/*!	@fn			SearchMatcher NewSearchMatcher (void)
+ *  @brief		새로운 SearchMatcher 객체를 생성한다.
+ *  @param[in]	void
+ *  @param[out] null
+ *  @retval 	SearchMatcher
+ *  @note 		새로운 SearchMatcher 객체를 생성한다. \n
+ *  			아무 조건도 추가하지 않은 SearchMatcher 는 모든 파일과 일치한다.
+ *  @see 		DestroySearchMatcher \n
+ *  			addSearchMatcherGlob \n
+ *  			addSearchMatcherRegex \n
+ *  			setSearchMatcherSize \n
+ *  			setSearchMatcherModifiedTime \n
+ *  			setSearchMatcherType
+ *  @warning    사용이 끝났을 때 DestroySearchMatcher() 함수를 꼭 사용해야 한다.
+ */
+SearchMatcher NewSearchMatcher (void);
+
+/*! @fn 		void DestroySearchMatcher (SearchMatcher this_gen)
+ *  @brief 		생성한 SearchMatcher 객체를 소멸 시킨다.
+ *  @param[in] 	this_gen 소멸시킬 SearchMatcher 객체
+ *  @param[out] null
+ *  @retval 	void
+ *  @note 		생성한 SearchMatcher 객체와 compile 된 조건들을 소멸 시킨다.
+ *  @see 		NewSearchMatcher
+ */
+void DestroySearchMatcher (SearchMatcher this_gen);
+
+/*! @fn 		bool addSearchMatcherGlob (SearchMatcher this_gen, String pattern)
+ *  @brief 		glob 형식의 이름 조건을 추가한다.
+ *  @param[in] 	this_gen 조건을 추가할 SearchMatcher 객체
+ *  @param[in] 	pattern glob pattern (예: @c "*.jpg", @c "IMG_????.png")
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		wildcard 가 없거나 @c "abc*" , @c "*abc" , @c "*abc*" 형태의 pattern 은 \n
+ *  			문자열 비교만으로 검사한다. 그 외의 pattern 은 앞뒤 literal 부분을 먼저 비교한 후 @c fnmatch() 로 검사한다.
+ *  @see 		NewSearchMatcher \n
+ *  			addSearchMatcherRegex
+ */
+bool addSearchMatcherGlob (SearchMatcher this_gen, String pattern);
+
+/*! @fn 		bool addSearchMatcherRegex (SearchMatcher this_gen, String pattern)
+ *  @brief 		정규식 이름 조건을 추가한다.
+ *  @param[in] 	this_gen 조건을 추가할 SearchMatcher 객체
+ *  @param[in] 	pattern 정규식 (PCRE 문법)
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		정규식은 파일 이름 전체와 일치해야 한다(앞뒤 anchored). \n
+ *  			정규식 앞부분의 literal 부분은 정규식 검사 전에 문자열 비교로 먼저 검사한다.
+ *  @see 		NewSearchMatcher \n
+ *  			addSearchMatcherGlob
+ */
+bool addSearchMatcherRegex (SearchMatcher this_gen, String pattern);
+
+/*! @fn 		bool setSearchMatcherSize (SearchMatcher this_gen, long long minSize, long long maxSize)
+ *  @brief 		파일 크기 조건을 설정한다.
+ *  @param[in] 	this_gen 조건을 설정할 SearchMatcher 객체
+ *  @param[in] 	minSize 최소 크기 (byte, 음수이면 제한 없음)
+ *  @param[in] 	maxSize 최대 크기 (byte, 음수이면 제한 없음)
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		크기 조건은 이름과 종류 조건을 만족한 entry 에 대해서만 @c stat 으로 검사한다.
+ *  @see 		NewSearchMatcher \n
+ *  			setSearchMatcherModifiedTime
+ */
+bool setSearchMatcherSize (SearchMatcher this_gen, long long minSize, long long maxSize);
+
+/*! @fn 		bool setSearchMatcherModifiedTime (SearchMatcher this_gen, time_t after, time_t before)
+ *  @brief 		파일 수정 시간 조건을 설정한다.
+ *  @param[in] 	this_gen 조건을 설정할 SearchMatcher 객체
+ *  @param[in] 	after 이 시간 이후에 수정된 파일만 검색한다 (0 이면 제한 없음)
+ *  @param[in] 	before 이 시간 이전에 수정된 파일만 검색한다 (0 이면 제한 없음)
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		수정 시간 조건은 이름과 종류 조건을 만족한 entry 에 대해서만 @c stat 으로 검사한다.
+ *  @see 		NewSearchMatcher \n
+ *  			setSearchMatcherSize
+ */
+bool setSearchMatcherModifiedTime (SearchMatcher this_gen, time_t after, time_t before);
+
+/*! @fn 		bool setSearchMatcherType (SearchMatcher this_gen, search_type_e type)
+ *  @brief 		파일 종류 조건을 설정한다.
+ *  @param[in] 	this_gen 조건을 설정할 SearchMatcher 객체
+ *  @param[in] 	type 검색할 파일의 종류
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		symbolic link 는 따라가지 않고 link 자체의 종류로 판단한다.
+ *  @see 		NewSearchMatcher
+ */
+bool setSearchMatcherType (SearchMatcher this_gen, search_type_e type);
+/* SearchMatcher */
+
+
 /* File */
+/*! @fn         bool (* SearchCallback) (String path, void * user_data)
+ *  @brief      searchFileForeach() 에서 검색된 파일마다 호출되는 callback 이다.
+ *  @param[in]  path 검색된 파일의 절대 경로
+ *  @param[in]  user_data searchFileForeach() 에 전달한 user data
+ *  @param[out] null
+ *  @retval     bool \n
+ *              @c true 이면 검색을 계속하고 @c false 이면 검색을 중단한다.
+ *  @warning    @a path 는 callback 이 반환된 후 해제되므로 보관하려면 복사해야 한다.
+ */
+typedef bool (* SearchCallback) (String path, void * user_data);
+
+/*! @enum   copy_mode_e
+ *  @brief  copyFileMode() 에서 clone (reflink) 을 사용하는 방식이다.
+ */
+typedef enum
+{
+    COPY_MODE_CLONE_OR_COPY = 0, /**< clone 을 먼저 시도하고 안되면 복사 */
+    COPY_MODE_CLONE,             /**< clone 만 시도하며 안되면 실패 */
+    COPY_MODE_COPY               /**< 항상 데이터를 복사 */
+
+} copy_mode_e;
+
+/*! @enum   checksum_type_e
+ *  @brief  copyFileChecksum() / checksumFile() 에서 사용할 checksum 종류이다.
+ */
+typedef enum
+{
+    CHECKSUM_CRC32C = 0, /**< CRC-32C (Castagnoli), 하위 32 bit 사용 */
+    CHECKSUM_XXHASH64    /**< xxHash64 (seed 0) */
+
+} checksum_type_e;
+
+/*! @enum   file_operation_e
+ *  @brief  runFileBatch() 로 수행할 작업의 종류이다.
+ */
+typedef enum
+{
+    FILE_OPERATION_DELETE = 0, /**< @a src 삭제 */
+    FILE_OPERATION_COPY,       /**< @a src 를 @a dst 로 복사 */
+    FILE_OPERATION_MOVE        /**< @a src 를 @a dst 로 이동 */
+
+} file_operation_e;
+
+/*! @struct	FileOperation
+ *  @brief	runFileBatch() 로 수행할 하나의 작업이다.
+ *  @note	@a result 는 runFileBatch() 가 채우며 성공하면 0, 실패하면 원인이 되는 errno 값이다.
+ */
+typedef struct _FileOperation
+{
+    file_operation_e type;
+    String           src;
+    String           dst;
+    int              result;
+
+} FileOperation;
+
+/*! @struct	AtomicWrite
+ *  @brief	writeFilesAtomic() 으로 기록할 하나의 파일이다.
+ *  @note	@a result 는 writeFilesAtomic() 이 채우며 성공하면 0, 실패하면 원인이 되는 errno 값이다.
+ */
+typedef struct _AtomicWrite
+{
+    String       path;
+    const void * data;
+    size_t       size;
+    int          result;
+
+} AtomicWrite;
+
+/*! @struct	DiskUsageInfo
+ *  @brief	getDiskUsage() / getDiskUsageInfo() 로 구한 directory 의 사용량이다.
+ *  @note	@a size 는 파일 크기의 합, @a allocated 는 directory 를 포함하여 실제로 할당된 block 크기의 합 (byte) 이다. \n
+ *          hard link 로 연결된 파일은 한번만 계산되며 @a directories 는 자신을 포함한 directory 수이다.
+ */
+typedef struct _DiskUsageInfo
+{
+    long long size;
+    long long allocated;
+    long long files;
+    long long directories;
+
+} DiskUsageInfo;
+
 /*! @struct	_File
  *  @brief	File 모듈에 대한 구조체이다. File 모듈은 다양한 방식으로 파일을 제어 할 수 있다.
  *  @note	File의 File 모듈에 대한 구조체이다. \n
@@ -113,11 +348,45 @@ struct _File
 
     bool (* Copy) (String src, String dst);
 
+    bool (* CopyMode) (String src, String dst, copy_mode_e mode);
+
+    bool (* CopyChecksum) (String src, String dst, checksum_type_e type, uint64_t * checksum);
+
+    bool (* CopyParallel) (String src, String dst, int threadCount, long long chunkSize);
+
+    bool (* CopyTree) (String src, String dst, int threadCount);
+
+    bool (* MoveTree) (String src, String dst, int threadCount);
+
+    bool (* DeleteTree) (String src, int threadCount);
+
+    bool (* Checksum) (String src, checksum_type_e type, uint64_t * checksum);
+
     bool (* Move) (String src, String dst);
 
     GList * (* Search) (String src, String dst);
 
+    GList * (* SearchParallel) (String src, String dst, int threadCount);
+
+    bool (* SearchForeach) (String src, String dst, int threadCount, int maxResults, SearchCallback callback, void * user_data);
+
+    GList * (* SearchMatch) (String src, SearchMatcher matcher, int threadCount);
+
+    bool (* SearchMatchForeach) (String src, SearchMatcher matcher, int threadCount, int maxResults, SearchCallback callback, void * user_data);
+
     void (* deleteSearchedList) (GList * searchedList);
+
+    bool (* Batch) (FileOperation * operations, int count, int threadCount, bool sync);
+
+    bool (* WriteAtomic) (String path, const void * data, size_t size);
+
+    bool (* WriteAtomicBatch) (AtomicWrite * writes, int count);
+
+    GList * (* FindDuplicates) (String src, int threadCount);
+
+    void (* deleteDuplicates) (GList * groups);
+
+    bool (* Usage) (String src, int threadCount, DiskUsageInfo * info);
 };
 
 /*!	@fn			File NewFile (void)
@@ -130,9 +399,26 @@ struct _File
  *  @see 		DestroyFile \n
  *  			deleteFile \n
  *  			copyFile \n
+ *  			copyFileMode \n
+ *  			copyFileChecksum \n
+ *  			copyFileParallel \n
+ *  			checksumFile \n
+ *  			copyTree \n
+ *  			moveTree \n
+ *  			deleteTree \n
  *  			moveFile \n
  *  			searchFile \n
- *  			deleteSearchedList
+ *  			searchFileParallel \n
+ *  			searchFileForeach \n
+ *  			searchFileMatch \n
+ *  			searchFileMatchForeach \n
+ *  			deleteSearchedList \n
+ *  			runFileBatch \n
+ *  			writeFileAtomic \n
+ *  			writeFilesAtomic \n
+ *  			findDuplicateFiles \n
+ *  			deleteDuplicateList \n
+ *  			getDiskUsage
  *  @pre    	@b privilege \n
  *              * http://tizen.org/privilege/mediastorage \n
  *              * http://tizen.org/privilege/externalstorage
@@ -145,9 +431,26 @@ File NewFile (void)
 
     this->Delete             = deleteFile;
     this->Copy               = copyFile;
+    this->CopyMode           = copyFileMode;
+    this->CopyChecksum       = copyFileChecksum;
+    this->CopyParallel       = copyFileParallel;
+    this->CopyTree           = copyTree;
+    this->MoveTree           = moveTree;
+    this->DeleteTree         = deleteTree;
+    this->Checksum           = checksumFile;
     this->Move               = moveFile;
     this->Search             = searchFile;
+    this->SearchParallel     = searchFileParallel;
+    this->SearchForeach      = searchFileForeach;
+    this->SearchMatch        = searchFileMatch;
+    this->SearchMatchForeach = searchFileMatchForeach;
     this->deleteSearchedList = deleteSearchedList;
+    this->Batch              = runFileBatch;
+    this->WriteAtomic        = writeFileAtomic;
+    this->WriteAtomicBatch   = writeFilesAtomic;
+    this->FindDuplicates     = findDuplicateFiles;
+    this->deleteDuplicates   = deleteDuplicateList;
+    this->Usage              = getDiskUsage;
     return this;
 }
  *	@endcode
@@ -175,96 +478,1482 @@ void DestroyFile (File this_gen);
  *  @retval 	bool \n
  *              함수의 성공 여부를 반환한다. \n
  *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
- *  @note 		해당 파일을 삭제한다. \n
- *  @see 		NewFile
- *  @pre        @b privilege \n
- *              * http://tizen.org/privilege/mediastorage \n
- *              * http://tizen.org/privilege/externalstorage
+ *  @note 		해당 파일을 삭제한다. \n
+ *  @see 		NewFile
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ */
+bool deleteFile (String src);
+
+/*! @fn 		bool copyFile (String src, String dst);
+ *  @brief 		해당 파일을 복사한다.
+ *  @param[in] 	src 복사할 파일의 path
+ *  @param[in] 	dst 붙여넣을 위치의 파일의 path
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		해당 파일을 복사한다. \n
+ *  			btrfs / xfs 등 copy-on-write 파일 시스템에서는 데이터를 복사하지 않고 @c FICLONE 으로 공유한다. \n
+ *  			clone 할 수 없으면 커널 내부 복사인 @c copy_file_range() 를 우선 사용하며 \n
+ *  			지원되지 않는 경우 @c sendfile() , 정렬된 대용량 버퍼 순으로 대체하여 복사한다. \n
+ *  			hole 이 있는 파일은 data 구간만 복사하여 hole 을 유지한다. \n
+ *  			기존 대상 파일이 있으면 그 파일에 그대로 덮어쓰며 실패하면 이 함수가 새로 만든 파일만 지운다. \n
+ *  			원본과 대상이 같은 파일이면 실패한다. \n
+ *  			대상 파일은 원본 파일의 권한으로 생성되며 기존 대상 파일이 있으면 그 권한을 유지한다.
+ *  @see 		NewFile \n
+ *  			DestroyFile \n
+ *  			deleteFile \n
+ *  			copyFileMode \n
+ *  			moveFile \n
+ *  			searchFile \n
+ *  			deleteSearchedList
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ */
+
+bool copyFile (String src, String dst);
+
+/*! @fn 		bool copyFileMode (String src, String dst, copy_mode_e mode)
+ *  @brief 		clone 사용 방식을 정하여 파일을 복사한다.
+ *  @param[in] 	src 복사할 파일의 path
+ *  @param[in] 	dst 붙여넣을 위치의 파일의 path
+ *  @param[in] 	mode clone 사용 방식
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		clone 사용 방식을 정하여 파일을 복사한다. \n
+ *  			@c COPY_MODE_CLONE_OR_COPY 는 copyFile() 과 같다. \n
+ *  			@c COPY_MODE_CLONE 은 clone 할 수 없으면 (다른 파일 시스템, 지원하지 않는 파일 시스템) 데이터를 복사하지 않고 실패한다. \n
+ *  			@c COPY_MODE_COPY 는 항상 데이터를 복사하여 원본과 block 을 공유하지 않는다. \n
+ *  			@c COPY_MODE_CLONE 은 같은 directory 의 임시 파일에 clone 한 후 rename 하므로 실패해도 기존 대상 파일이 남는다. \n
+ *  			이 경우 대상 파일은 새 inode 로 바뀌므로 link, 소유자, 확장 속성은 유지되지 않으며 directory 쓰기 권한이 필요하다. \n
+ *  			나머지 mode 는 기존 대상 파일에 그대로 덮어쓰며 실패하면 이 함수가 새로 만든 파일만 지운다.
+ *  @see 		copyFile
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ */
+bool copyFileMode (String src, String dst, copy_mode_e mode);
+
+/*! @fn 		bool copyFileChecksum (String src, String dst, checksum_type_e type, uint64_t * checksum)
+ *  @brief 		파일을 복사하면서 복사한 데이터의 checksum 을 계산한다.
+ *  @param[in] 	src 복사할 파일의 path
+ *  @param[in] 	dst 붙여넣을 위치의 파일의 path
+ *  @param[in] 	type checksum 종류
+ *  @param[out] checksum 복사한 데이터의 checksum
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		파일을 복사하면서 복사한 데이터의 checksum 을 계산한다. \n
+ *  			데이터를 한번만 읽으므로 복사 후 다시 읽어서 검증하는 것보다 I/O 가 절반이다. \n
+ *  			checksum 을 계산하기 위해 clone / 커널 내부 복사 / hole 유지 없이 버퍼로 복사한다. \n
+ *  			CRC-32C 는 SSE4.2 또는 ARMv8 CRC 명령어를 사용하도록 build 된 경우 이를 사용한다.
+ *  @see 		copyFile \n
+ *  			checksumFile
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ */
+bool copyFileChecksum (String src, String dst, checksum_type_e type, uint64_t * checksum);
+
+/*! @fn 		bool copyFileParallel (String src, String dst, int threadCount, long long chunkSize)
+ *  @brief 		큰 파일을 여러 조각으로 나누어 여러 thread 에서 동시에 복사한다.
+ *  @param[in] 	src 복사할 파일의 path
+ *  @param[in] 	dst 붙여넣을 위치의 파일의 path
+ *  @param[in] 	threadCount 사용할 thread 수 \n
+ *              0 이하이면 CPU core 수만큼 사용한다.
+ *  @param[in] 	chunkSize 한 thread 가 한번에 복사할 크기 (byte) \n
+ *              4096 의 배수로 올림하며 0 이하이면 8MB 를 사용한다.
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		큰 파일을 여러 조각으로 나누어 여러 thread 에서 동시에 복사한다. \n
+ *  			각 조각은 offset 을 지정한 @c copy_file_range() 또는 @c pread() / @c pwrite() 로 복사되며 \n
+ *  			모든 조각이 끝난 후 한번만 @c fsync() 한다. \n
+ *  			NVMe / RAID 처럼 동시 요청을 처리할 수 있는 저장 장치에서 효과가 있다. \n
+ *  			같은 directory 의 임시 파일에 복사한 후 rename 하므로 실패해도 기존 대상 파일이 남으며, 대상 파일은 새 inode 로 바뀐다. \n
+ *  			복사 도중 원본이 줄어들면 실패한다. \n
+ *  			조각이 두 개 이하인 작은 파일과 hole 이 있는 파일은 copyFile() 과 같이 복사한다.
+ *  @see 		copyFile
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ */
+bool copyFileParallel (String src, String dst, int threadCount, long long chunkSize);
+
+/*! @fn 		bool checksumFile (String src, checksum_type_e type, uint64_t * checksum)
+ *  @brief 		파일 내용의 checksum 을 계산한다.
+ *  @param[in] 	src checksum 을 계산할 파일의 path
+ *  @param[in] 	type checksum 종류
+ *  @param[out] checksum 파일 내용의 checksum
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		파일 내용의 checksum 을 계산한다. \n
+ *  			copyFileChecksum() 이 반환한 값과 비교할 수 있다.
+ *  @see 		copyFileChecksum
+ */
+bool checksumFile (String src, checksum_type_e type, uint64_t * checksum);
+/*! @fn 		bool moveFile (String src, String dst);
+ *  @brief 		해당 파일을 이동 시킨다.
+ *  @param[in] 	src 복사할 파일의 path
+ *  @param[in] 	dst 이동시킬 위치의 파일의 path
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		해당 파일을 이동 시킨다. \n
+ *  			같은 파일 시스템 안에서는 @c rename() 으로 데이터 복사 없이 이동한다. \n
+ *  			다른 파일 시스템으로 이동하는 경우(@c EXDEV)에만 copyFile() 과 같은 복사 엔진으로 \n
+ *  			권한과 시간 정보를 유지하여 복사하고 @c fsync() 한 후 원본 파일을 삭제한다. \n
+ *  			이동 후 원본과 대상 디렉토리를 모두 @c fsync() 하여 crash 이후에도 결과가 유지된다.
+ *  @see 		NewFile \n
+ *  			DestroyFile \n
+ *  			deleteFile \n
+ *  			copyFile \n
+ *  			searchFile \n
+ *  			deleteSearchedList
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ */
+bool moveFile (String src, String dst);
+
+/*! @fn 		bool copyTree (String src, String dst, int threadCount)
+ *  @brief 		directory 를 하위 항목까지 모두 복사한다.
+ *  @param[in] 	src 복사할 directory 의 path
+ *  @param[in] 	dst 붙여넣을 위치의 path
+ *  @param[in] 	threadCount 사용할 thread 수 \n
+ *              0 이하이면 CPU core 수만큼 사용한다.
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		directory 를 하위 항목까지 모두 복사한다. \n
+ *  			하위 directory 들은 여러 thread 에서 나누어 처리되며 파일은 copyFile() 과 같은 방법으로 복사된다. \n
+ *  			symbolic link 는 link 자체를 복사하며 따라가지 않는다. \n
+ *  			@a dst 가 이미 있는 directory 이면 그 안에 합쳐서 복사한다. \n
+ *  			이때 @a dst 안의 symbolic link 는 따라가지 않으며, 실패해도 원래 있던 파일은 지우지 않는다. \n
+ *  			@a dst 가 @a src 자신이거나 그 아래이면 실패한다. \n
+ *  			thread 당 최대 4 개의 파일을 열며 처리 대기중인 directory 만 메모리에 유지한다. \n
+ *  			@a src 가 directory 가 아니면 그 항목 하나만 복사한다.
+ *  @see 		moveTree \n
+ *  			deleteTree \n
+ *  			copyFile
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ *  @warning    실패하면 그때까지 복사된 항목은 남아 있다.
+ */
+bool copyTree (String src, String dst, int threadCount);
+
+/*! @fn 		bool moveTree (String src, String dst, int threadCount)
+ *  @brief 		directory 를 하위 항목까지 모두 이동한다.
+ *  @param[in] 	src 이동할 directory 의 path
+ *  @param[in] 	dst 이동시킬 위치의 path
+ *  @param[in] 	threadCount 다른 파일 시스템으로 복사할 때 사용할 thread 수 \n
+ *              0 이하이면 CPU core 수만큼 사용한다.
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		directory 를 하위 항목까지 모두 이동한다. \n
+ *  			같은 파일 시스템 안에서는 @c rename() 한번으로 끝난다. \n
+ *  			다른 파일 시스템이면 권한 / 시간을 유지하여 copyTree() 로 복사하고 @c fsync() 한 후 원본을 deleteTree() 로 삭제한다. \n
+ *  			복사에 실패하면 새로 만든 @a dst 를 지우고 원본은 그대로 둔다.
+ *  @see 		copyTree \n
+ *  			deleteTree \n
+ *  			moveFile
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ */
+bool moveTree (String src, String dst, int threadCount);
+
+/*! @fn 		bool deleteTree (String src, int threadCount)
+ *  @brief 		directory 를 하위 항목까지 모두 삭제한다.
+ *  @param[in] 	src 삭제할 directory 의 path
+ *  @param[in] 	threadCount 사용할 thread 수 \n
+ *              0 이하이면 CPU core 수만큼 사용한다.
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		directory 를 하위 항목까지 모두 삭제한다. \n
+ *  			하위 directory 들은 여러 thread 에서 나누어 처리되며 각 directory 는 내용이 모두 삭제된 후에 삭제된다. \n
+ *  			일부 항목을 삭제할 수 없어도 나머지는 계속 삭제한다. \n
+ *  			@a src 가 directory 가 아니면 그 항목 하나만 삭제한다.
+ *  @see 		copyTree \n
+ *  			moveTree \n
+ *  			deleteFile
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ */
+bool deleteTree (String src, int threadCount);
+
+/*! @fn 		bool runFileBatch (FileOperation * operations, int count, int threadCount, bool sync)
+ *  @brief 		여러 개의 삭제 / 복사 / 이동 작업을 한번에 수행한다.
+ *  @param[in] 	operations 수행할 작업 배열
+ *  @param[in] 	count @a operations 의 크기
+ *  @param[in] 	threadCount 사용할 thread 수 \n
+ *              0 이하이면 CPU core 수만큼 사용한다.
+ *  @param[in] 	sync @c true 이면 복사 / 이동된 파일과 변경된 directory 를 @c fsync() 한다.
+ *  @param[out] operations 각 작업의 @a result 에 성공이면 0, 실패이면 errno 값이 저장된다.
+ *  @retval 	bool \n
+ *              모든 작업이 성공하면 @c true 를 반환한다. \n
+ *              하나라도 실패하면 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		여러 개의 삭제 / 복사 / 이동 작업을 한번에 수행한다. \n
+ *  			작업들은 여러 thread 에서 나누어 수행되며 하나가 실패해도 나머지 작업은 계속 수행된다. \n
+ *  			@a sync 가 @c true 이면 directory 의 @c fsync() 는 모든 작업이 끝난 후 directory 마다 한번만 수행된다.
+ *  @see 		deleteFile \n
+ *  			copyFile \n
+ *  			moveFile
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ *  @warning    작업들의 수행 순서는 보장되지 않는다. 서로 의존하는 작업은 (예: 같은 파일의 복사 후 삭제) 한번에 넘기면 안된다.
+ */
+bool runFileBatch (FileOperation * operations, int count, int threadCount, bool sync);
+
+/*! @fn 		bool writeFileAtomic (String path, const void * data, size_t size)
+ *  @brief 		파일의 내용을 원자적으로 교체한다.
+ *  @param[in] 	path 기록할 파일의 path
+ *  @param[in] 	data 기록할 data
+ *  @param[in] 	size @a data 의 크기 (byte)
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		파일의 내용을 원자적으로 교체한다. \n
+ *  			같은 directory 의 임시 파일에 기록하고 @c fsync() 한 후 @c rename() 으로 @a path 를 교체하고 directory 를 @c fsync() 한다. \n
+ *  			crash 가 나도 @a path 는 이전 내용 또는 새 내용 중 하나로만 남는다. \n
+ *  			@a path 가 이미 있으면 그 권한을 유지한다.
+ *  @see 		writeFilesAtomic \n
+ *  			NewAtomicFile
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ */
+bool writeFileAtomic (String path, const void * data, size_t size);
+
+/*! @fn 		bool writeFilesAtomic (AtomicWrite * writes, int count)
+ *  @brief 		여러 파일의 내용을 한번에 원자적으로 교체한다.
+ *  @param[in] 	writes 기록할 파일 배열
+ *  @param[in] 	count @a writes 의 크기
+ *  @param[out] writes 각 항목의 @a result 에 성공이면 0, 실패이면 errno 값이 저장된다.
+ *  @retval 	bool \n
+ *              모든 파일이 성공하면 @c true 를 반환한다. \n
+ *              하나라도 실패하면 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		여러 파일의 내용을 한번에 원자적으로 교체한다. \n
+ *  			각 파일은 writeFileAtomic() 과 같이 교체되지만 @c fsync() 를 모아서 수행한다 (group commit). \n
+ *  			모든 임시 파일의 writeback 을 먼저 시작한 후 기다리며 directory 의 @c fsync() 는 directory 마다 한번만 수행한다. \n
+ *  			하나가 실패해도 나머지 파일은 교체된다.
+ *  @see 		writeFileAtomic \n
+ *  			commitAtomicFiles
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ *  @warning    같은 @a path 를 여러번 넘기면 어느 내용이 남을지 보장되지 않는다.
+ */
+bool writeFilesAtomic (AtomicWrite * writes, int count);
+
+/*! @fn 		GList * searchFile (String src, String dst)
+ *  @brief 		파일을 검색한다.
+ *  @param[in] 	src 검색을 수행 할 위치의 path
+ *  @param[in] 	dst 검색 할 파일의 이름
+ *  @param[out] null
+ *  @retval 	GList*
+ *  @note 		@a src 폴더 내부에서 @a dst 키워드를 가진 파일을 검색한다. \n
+ *  			검색 결과는 각 파일의 절대 경로(realpath)를 담은 리스트이다. \n
+ *  			@c openat() 기반으로 탐색하므로 process의 현재 작업 디렉토리를 변경하지 않는다. \n
+ *  			디렉토리는 @c getdents64 로 한번에 읽으며 파일 시스템이 @c d_type 을 제공하지 않는 경우에만 @c stat 을 호출한다.
+ *  @see 		NewFile \n
+ *  			DestroyFile \n
+ *  			deleteFile \n
+ *  			copyFile \n
+ *  			moveFile \n
+ *  			searchFileParallel \n
+ *  			deleteSearchedList
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ *  @warning    검색 결과 리스트는 사용이 끝났을 때 deleteSearchedList() 함수로 삭제해야 한다.
+ */
+GList * searchFile (String src, String dst);
+
+/*! @fn 		GList * searchFileParallel (String src, String dst, int threadCount)
+ *  @brief 		여러 thread를 사용하여 파일을 검색한다.
+ *  @param[in] 	src 검색을 수행 할 위치의 path
+ *  @param[in] 	dst 검색 할 파일의 이름
+ *  @param[in] 	threadCount 검색에 사용할 thread 수 (0 이하이면 CPU core 수)
+ *  @param[out] null
+ *  @retval 	GList*
+ *  @note 		searchFile() 과 같은 결과를 반환하지만 하위 디렉토리들을 여러 thread가 나누어 탐색한다. \n
+ *  			각 thread는 자신의 작업 queue가 비면 다른 thread의 queue에서 디렉토리를 가져온다(work-stealing). \n
+ *  			process의 현재 작업 디렉토리를 변경하지 않으므로 다른 thread와 함께 사용해도 안전하다.
+ *  @see 		NewFile \n
+ *  			DestroyFile \n
+ *  			searchFile \n
+ *  			deleteSearchedList
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ *  @warning    결과 리스트의 순서는 실행할 때마다 달라질 수 있다. \n
+ *              검색 결과 리스트는 사용이 끝났을 때 deleteSearchedList() 함수로 삭제해야 한다.
+ */
+GList * searchFileParallel (String src, String dst, int threadCount);
+
+/*! @fn 		bool searchFileForeach (String src, String dst, int threadCount, int maxResults, SearchCallback callback, void * user_data)
+ *  @brief 		파일을 검색하면서 찾은 결과를 바로 callback 으로 전달한다.
+ *  @param[in] 	src 검색을 수행 할 위치의 path
+ *  @param[in] 	dst 검색 할 파일의 이름
+ *  @param[in] 	threadCount 검색에 사용할 thread 수 (0 이하이면 CPU core 수)
+ *  @param[in] 	maxResults 전달 받을 최대 결과 수 (0 이하이면 제한 없음)
+ *  @param[in] 	callback 검색된 파일마다 호출 될 callback
+ *  @param[in] 	user_data callback 에 전달 될 user data
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		searchFile() 과 달리 결과 리스트를 만들지 않고 파일을 찾는 즉시 @a callback 을 호출한다. \n
+ *  			@a callback 이 @c false 를 반환하거나 @a maxResults 개의 결과를 전달하면 탐색을 바로 중단한다. \n
+ *  			결과를 보관하지 않으므로 탐색하는 tree의 크기와 관계없이 사용하는 memory가 일정하다.
+ *  @see 		NewFile \n
+ *  			searchFile \n
+ *  			searchFileParallel
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ *  @warning    @a callback 은 검색 thread 에서 호출되며 동시에 두 번 호출되지는 않는다. \n
+ *              이 함수는 탐색이 끝나거나 중단될 때까지 반환하지 않는다.
+ */
+bool searchFileForeach (String src, String dst, int threadCount, int maxResults, SearchCallback callback, void * user_data);
+
+/*! @fn 		GList * searchFileMatch (String src, SearchMatcher matcher, int threadCount)
+ *  @brief 		SearchMatcher 의 조건과 일치하는 파일을 검색한다.
+ *  @param[in] 	src 검색을 수행 할 위치의 path
+ *  @param[in] 	matcher 검색 조건
+ *  @param[in] 	threadCount 검색에 사용할 thread 수 (0 이하이면 CPU core 수)
+ *  @param[out] null
+ *  @retval 	GList*
+ *  @note 		searchFileParallel() 과 같은 방식으로 탐색하며 이름이 같은 파일 대신 @a matcher 의 조건과 일치하는 파일을 반환한다. \n
+ *  			여러 이름 조건을 하나의 @a matcher 에 추가하면 한번의 탐색으로 모두 검색할 수 있다.
+ *  @see 		NewSearchMatcher \n
+ *  			searchFileMatchForeach \n
+ *  			deleteSearchedList
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ *  @warning    검색 결과 리스트는 사용이 끝났을 때 deleteSearchedList() 함수로 삭제해야 한다.
+ */
+GList * searchFileMatch (String src, SearchMatcher matcher, int threadCount);
+
+/*! @fn 		bool searchFileMatchForeach (String src, SearchMatcher matcher, int threadCount, int maxResults, SearchCallback callback, void * user_data)
+ *  @brief 		SearchMatcher 의 조건과 일치하는 파일을 찾는 즉시 callback 으로 전달한다.
+ *  @param[in] 	src 검색을 수행 할 위치의 path
+ *  @param[in] 	matcher 검색 조건
+ *  @param[in] 	threadCount 검색에 사용할 thread 수 (0 이하이면 CPU core 수)
+ *  @param[in] 	maxResults 전달 받을 최대 결과 수 (0 이하이면 제한 없음)
+ *  @param[in] 	callback 검색된 파일마다 호출 될 callback
+ *  @param[in] 	user_data callback 에 전달 될 user data
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		searchFileForeach() 와 같이 동작하며 @a matcher 의 조건으로 검색한다.
+ *  @see 		NewSearchMatcher \n
+ *  			searchFileMatch \n
+ *  			searchFileForeach
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ *  @warning    @a callback 은 검색 thread 에서 호출되며 동시에 두 번 호출되지는 않는다.
+ */
+bool searchFileMatchForeach (String src, SearchMatcher matcher, int threadCount, int maxResults, SearchCallback callback, void * user_data);
+
+/*! @fn 		void deleteSearchedList (GList * searchedList)
+ *  @brief 		파일 검색 결과 리스트를 삭제한다.
+ *  @param[in] 	searchedList 삭제할 파일 검색 결과 리스트
+ *  @param[out] null
+ *  @retval 	void
+ *  @note 		파일 검색 결과 리스트를 삭제한다. \n
+ *  @see 		NewFile \n
+ *  			DestroyFile \n
+ *  			deleteFile \n
+ *  			copyFile \n
+ *  			moveFile \n
+ *  			searchFile
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ */
+void deleteSearchedList (GList * searchedList);
+
+/*! @fn 		GList * findDuplicateFiles (String src, int threadCount)
+ *  @brief 		내용이 같은 파일들을 찾는다.
+ *  @param[in] 	src 검색을 수행 할 위치의 path
+ *  @param[in] 	threadCount 탐색 / 읽기에 사용할 thread 수 (0 이하이면 CPU core 수)
+ *  @param[out] null
+ *  @retval 	GList* \n
+ *              내용이 같은 파일들의 group 리스트이며 각 group 은 절대 경로를 담은 GList 이다. \n
+ *              중복이 없거나 실패하면 @c NULL 을 반환한다.
+ *  @note 		@a src 폴더 내부에서 내용이 같은 파일들을 찾는다. \n
+ *  			먼저 크기로 나누고, 크기가 같은 파일은 앞 4 KB 의 hash 를, 앞부분까지 같은 파일만 전체 내용의 hash (xxHash64) 를 비교하여 읽는 양을 최소로 한다. \n
+ *  			각 단계의 파일 읽기는 여러 thread 에서 나누어 수행한다. \n
+ *  			hard link 는 한번만 읽으며 같은 group 에 포함된다. 빈 파일과 symbolic link 는 제외한다. \n
+ *  			group 은 파일 크기가 큰 순서이며 group 안의 경로는 이름 순이다.
+ *  @see 		deleteDuplicateList \n
+ *  			searchFile \n
+ *  			checksumFile
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ *  @warning    내용 비교는 64 bit hash 로 하므로 삭제 전에 필요하면 직접 비교해야 한다. \n
+ *              결과 리스트는 사용이 끝났을 때 deleteDuplicateList() 함수로 삭제해야 한다.
+ */
+GList * findDuplicateFiles (String src, int threadCount);
+
+/*! @fn 		void deleteDuplicateList (GList * groups)
+ *  @brief 		findDuplicateFiles() 의 결과 리스트를 삭제한다.
+ *  @param[in] 	groups 삭제할 결과 리스트
+ *  @param[out] null
+ *  @retval 	void
+ *  @note 		findDuplicateFiles() 의 결과 리스트를 각 group 과 경로까지 모두 삭제한다.
+ *  @see 		findDuplicateFiles
+ */
+void deleteDuplicateList (GList * groups);
+
+/*! @fn 		bool getDiskUsage (String src, int threadCount, DiskUsageInfo * info)
+ *  @brief 		directory 의 사용량을 구한다.
+ *  @param[in] 	src 사용량을 구할 directory 의 path
+ *  @param[in] 	threadCount 탐색에 사용할 thread 수 (0 이하이면 CPU core 수)
+ *  @param[out] info 하위 항목까지 합산한 사용량
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              읽을 수 없는 directory 가 있으면 나머지를 합산한 @a info 를 채우고 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		directory 의 사용량을 하위 항목까지 합산하여 구한다 (du). \n
+ *  			하위 directory 들은 여러 thread 에서 나누어 탐색한다. \n
+ *  			같은 directory 를 여러번 확인해야 하면 NewDiskUsage() 로 snapshot 을 만들어 updateDiskUsage() 를 사용하는 것이 빠르다.
+ *  @see 		NewDiskUsage
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ */
+bool getDiskUsage (String src, int threadCount, DiskUsageInfo * info);
+/* File */
+
+/* CopyJob */
+/*! @enum   copy_job_state_e
+ *  @brief  CopyJob 의 상태이다.
+ */
+typedef enum
+{
+    COPY_JOB_RUNNING = 0, /**< 복사중 */
+    COPY_JOB_DONE,        /**< 복사 완료 */
+    COPY_JOB_FAILED,      /**< 복사 실패 */
+    COPY_JOB_CANCELED     /**< 취소됨 */
+
+} copy_job_state_e;
+
+/*! @struct	CopyProgress
+ *  @brief	CopyJob 의 진행 상황이다.
+ *  @note	@a bytesPerSecond 는 최근 구간에 가중치를 둔 평균 속도이며 @a eta 는 이 속도로 계산한 남은 시간 (초) 이다. \n
+ *          속도를 아직 알 수 없으면 @a eta 는 -1 이다.
+ */
+typedef struct _CopyProgress
+{
+    long long        copied;
+    long long        total;
+    double           bytesPerSecond;
+    double           eta;
+    copy_job_state_e state;
+
+} CopyProgress;
+
+typedef struct _CopyJob * CopyJob;
+
+typedef void (* CopyProgressCallback) (CopyJob job, CopyProgress * progress, void * user_data);
+
+/*! @struct	_CopyJob
+ *  @brief	CopyJob 모듈에 대한 구조체이다. CopyJob 모듈은 파일 하나를 worker thread 에서 복사한다.
+ *  @note	File의 CopyJob 모듈에 대한 구조체이다. \n
+    		NewCopyJob() 으로 생성하면 바로 복사가 시작되며 사용이 끝났을 때 DestroyCopyJob() 함수를 꼭 사용해야 한다. \n
+    		복사는 copyFile() 과 같은 복사 엔진을 사용한다.
+ *  @see	copyFile
+ *  @pre	@b privilege \n
+ *          * http://tizen.org/privilege/mediastorage \n
+ *  		* http://tizen.org/privilege/externalstorage
+ */
+struct _CopyJob
+{
+    bool (* Cancel) (CopyJob this_gen);
+
+    bool (* Wait) (CopyJob this_gen);
+
+    CopyProgress (* getProgress) (CopyJob this_gen);
+};
+
+typedef struct _CopyJobExtends
+{
+    struct _CopyJob      job;
+    String               src;
+    String               dst;
+    GThread            * thread;
+    GMutex               lock;
+    CopyProgressCallback callback;
+    void               * user_data;
+    gint64               interval;   // callback 최소 간격 (us)
+    gint64               start;
+    gint64               lastTime;
+    long long            lastCopied;
+    CopyProgress         progress;
+    volatile gint        cancel;
+    bool                 joined;
+
+} CopyJobExtends;
+
+/*!	@fn			CopyJob NewCopyJob (String src, String dst, CopyProgressCallback callback, int interval, void * data)
+ *  @brief		새로운 CopyJob 객체를 생성하고 복사를 시작한다.
+ *  @param[in]	src 복사할 파일의 path
+ *  @param[in]	dst 복사될 위치의 파일의 path
+ *  @param[in]	callback 진행 상황을 전달 받을 callback 함수 (@c NULL 가능)
+ *  @param[in]	interval callback 호출 사이의 최소 간격 (ms) \n
+ *              0 이하이면 200ms 를 사용한다.
+ *  @param[in]	data callback 함수에 전달될 사용자 data 주소
+ *  @param[out] null
+ *  @retval 	CopyJob \n
+ *              복사를 시작하지 못하면 @c NULL 을 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		새로운 CopyJob 객체를 생성하고 복사를 시작한다. \n
+ *  			@a callback 은 최대 @a interval 마다 한번 호출되며 복사가 끝나면 최종 상태로 한번 더 호출된다.
+ *  @see 		DestroyCopyJob \n
+ *  			cancelCopyJob \n
+ *  			waitCopyJob \n
+ *  			getCopyJobProgress
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ *  @warning    @a callback 은 worker thread 에서 호출된다. UI 를 갱신하려면 ecore_main_loop_thread_safe_call_async() 등으로 main loop 에 넘겨야 한다. \n
+ *              사용이 끝났을 때 DestroyCopyJob() 함수를 꼭 사용해야 한다.
+ *
+ *  @code{.c}
+ *  CopyJob NewCopyJob (String src, String dst, CopyProgressCallback callback, int interval, void * data)
+ *  {
+ *      CopyJobExtends * this = (CopyJobExtends *)malloc (sizeof (CopyJobExtends));
+ *
+ *      this->job.Cancel      = cancelCopyJob;
+ *      this->job.Wait        = waitCopyJob;
+ *      this->job.getProgress = getCopyJobProgress;
+ *
+ *      ...
+ *
+ *      this->thread = g_thread_try_new ("CopyJob", copy_job_run, this, NULL);
+ *      return &this->job;
+ *  }
+ *  @endcode
+ */
+CopyJob NewCopyJob (String src, String dst, CopyProgressCallback callback, int interval, void * data);
+
+/*! @fn 		void DestroyCopyJob (CopyJob this_gen)
+ *  @brief 		생성한 CopyJob 객체를 소멸 시킨다.
+ *  @param[in] 	this_gen 소멸시킬 CopyJob 객체
+ *  @param[out] null
+ *  @retval 	void
+ *  @note 		생성한 CopyJob 객체를 소멸 시킨다. \n
+ *  			복사중이면 취소하고 worker thread 가 끝날 때까지 기다린다.
+ *  @see 		NewCopyJob
+ *  @warning    callback 안에서 호출하면 안된다.
+ */
+void DestroyCopyJob (CopyJob this_gen);
+
+/*! @fn 		bool cancelCopyJob (CopyJob this_gen)
+ *  @brief 		복사를 취소한다.
+ *  @param[in] 	this_gen 취소할 CopyJob 객체
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		복사를 취소한다. \n
+ *  			취소는 다음 chunk 를 복사하기 전에 반영되며 복사중이던 @a dst 파일은 삭제된다. \n
+ *  			기다리지 않고 바로 반환하며 callback 에서도 호출할 수 있다.
+ *  @see 		NewCopyJob \n
+ *  			waitCopyJob
+ */
+bool cancelCopyJob (CopyJob this_gen);
+
+/*! @fn 		bool waitCopyJob (CopyJob this_gen)
+ *  @brief 		복사가 끝날 때까지 기다린다.
+ *  @param[in] 	this_gen 기다릴 CopyJob 객체
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              복사가 성공했으면 @c true, 실패하거나 취소되었으면 @c false 를 반환한다.
+ *  @note 		복사가 끝날 때까지 기다린다.
+ *  @see 		NewCopyJob \n
+ *  			cancelCopyJob
+ *  @warning    callback 안에서 호출하면 안된다.
+ */
+bool waitCopyJob (CopyJob this_gen);
+
+/*! @fn 		CopyProgress getCopyJobProgress (CopyJob this_gen)
+ *  @brief 		현재 진행 상황을 반환한다.
+ *  @param[in] 	this_gen 진행 상황을 확인할 CopyJob 객체
+ *  @param[out] null
+ *  @retval 	CopyProgress
+ *  @note 		현재 진행 상황을 반환한다. \n
+ *  			복사 byte 수는 chunk 단위로 갱신되며 속도와 남은 시간은 callback 간격마다 갱신된다.
+ *  @see 		NewCopyJob
+ */
+CopyProgress getCopyJobProgress (CopyJob this_gen);
+/* CopyJob */
+
+/* AtomicFile */
+/*! @struct	_AtomicFile
+ *  @brief	AtomicFile 모듈에 대한 구조체이다. AtomicFile 모듈은 파일의 내용을 나누어 기록한 후 한번에 원자적으로 교체한다.
+ *  @note	File의 AtomicFile 모듈에 대한 구조체이다. \n
+    		NewAtomicFile() 로 생성한 후 Write 로 내용을 기록하고 Commit 으로 교체하며 사용이 끝났을 때 DestroyAtomicFile() 함수를 꼭 사용해야 한다. \n
+    		Commit 전까지 원래 파일은 바뀌지 않는다.
+ *  @see	writeFileAtomic
+ *  @pre	@b privilege \n
+ *          * http://tizen.org/privilege/mediastorage \n
+ *  		* http://tizen.org/privilege/externalstorage
+ */
+typedef struct _AtomicFile * AtomicFile;
+struct _AtomicFile
+{
+    bool (* Write) (AtomicFile this_gen, const void * data, size_t size);
+
+    bool (* Commit) (AtomicFile this_gen);
+};
+
+typedef struct _AtomicFileExtends
+{
+    struct _AtomicFile file;
+    String             path;
+    String             temp;
+    int                fd;
+    char             * buffer;
+    size_t             used;
+    int                error;  // 처음 실패한 errno
+    bool               done;
+
+} AtomicFileExtends;
+
+/*!	@fn			AtomicFile NewAtomicFile (String path)
+ *  @brief		새로운 AtomicFile 객체를 생성한다.
+ *  @param[in]	path 교체할 파일의 path
+ *  @param[out] null
+ *  @retval 	AtomicFile \n
+ *              임시 파일을 만들지 못하면 @c NULL 을 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		새로운 AtomicFile 객체를 생성한다. \n
+ *  			@a path 와 같은 directory 에 임시 파일을 만든다.
+ *  @see 		DestroyAtomicFile \n
+ *  			writeAtomicFile \n
+ *  			commitAtomicFile \n
+ *  			commitAtomicFiles
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ *  @warning    사용이 끝났을 때 DestroyAtomicFile() 함수를 꼭 사용해야 한다.
+ *
+ *  @code{.c}
+ *  AtomicFile NewAtomicFile (String path)
+ *  {
+ *      AtomicFileExtends * this = (AtomicFileExtends *)malloc (sizeof (AtomicFileExtends));
+ *
+ *      this->file.Write  = writeAtomicFile;
+ *      this->file.Commit = commitAtomicFile;
+ *
+ *      ...
+ *
+ *      return &this->file;
+ *  }
+ *  @endcode
+ */
+AtomicFile NewAtomicFile (String path);
+
+/*! @fn 		void DestroyAtomicFile (AtomicFile this_gen)
+ *  @brief 		생성한 AtomicFile 객체를 소멸 시킨다.
+ *  @param[in] 	this_gen 소멸시킬 AtomicFile 객체
+ *  @param[out] null
+ *  @retval 	void
+ *  @note 		생성한 AtomicFile 객체를 소멸 시킨다. \n
+ *  			Commit 되지 않았으면 임시 파일을 삭제하며 원래 파일은 바뀌지 않는다.
+ *  @see 		NewAtomicFile
+ */
+void DestroyAtomicFile (AtomicFile this_gen);
+
+/*! @fn 		bool writeAtomicFile (AtomicFile this_gen, const void * data, size_t size)
+ *  @brief 		임시 파일에 내용을 이어서 기록한다.
+ *  @param[in] 	this_gen 기록할 AtomicFile 객체
+ *  @param[in] 	data 기록할 data
+ *  @param[in] 	size @a data 의 크기 (byte)
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		임시 파일에 내용을 이어서 기록한다. \n
+ *  			작은 기록은 내부 buffer 에 모아서 기록한다. \n
+ *  			한번 실패하면 이후의 기록과 Commit 은 모두 실패한다.
+ *  @see 		NewAtomicFile \n
+ *  			commitAtomicFile
+ */
+bool writeAtomicFile (AtomicFile this_gen, const void * data, size_t size);
+
+/*! @fn 		bool commitAtomicFile (AtomicFile this_gen)
+ *  @brief 		기록한 내용으로 파일을 교체한다.
+ *  @param[in] 	this_gen 교체할 AtomicFile 객체
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		기록한 내용으로 파일을 교체한다. \n
+ *  			임시 파일을 @c fsync() 한 후 @c rename() 하고 directory 를 @c fsync() 한다. \n
+ *  			실패하면 임시 파일을 삭제하며 원래 파일은 바뀌지 않는다.
+ *  @see 		NewAtomicFile \n
+ *  			writeAtomicFile \n
+ *  			commitAtomicFiles
+ *  @warning    Commit 은 한번만 할 수 있다.
+ */
+bool commitAtomicFile (AtomicFile this_gen);
+
+/*! @fn 		bool commitAtomicFiles (AtomicFile * files, int count)
+ *  @brief 		여러 AtomicFile 을 한번에 교체한다.
+ *  @param[in] 	files 교체할 AtomicFile 배열
+ *  @param[in] 	count @a files 의 크기
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              모든 파일이 성공하면 @c true 를 반환한다. \n
+ *              하나라도 실패하면 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		여러 AtomicFile 을 한번에 교체한다 (group commit). \n
+ *  			@c fdatasync() 는 파일마다 한번씩 하지만 모든 임시 파일의 writeback 을 먼저 시작하므로 파일마다 따로 Commit 하는 것보다 기다리는 시간이 짧다. \n
+ *  			directory 의 @c fsync() 는 모든 @c rename() 이 끝난 후 directory 마다 한번만 수행한다. \n
+ *  			하나가 실패해도 나머지 파일은 교체된다.
+ *  @see 		commitAtomicFile \n
+ *  			writeFilesAtomic
+ */
+bool commitAtomicFiles (AtomicFile * files, int count);
+/* AtomicFile */
+
+/* MappedFile */
+/*! @enum   mapped_file_advice_e
+ *  @brief  MappedFile 의 접근 방식에 대한 hint 이다.
+ */
+typedef enum
+{
+    MAPPED_FILE_ADVICE_NORMAL = 0, /**< 기본 readahead */
+    MAPPED_FILE_ADVICE_SEQUENTIAL, /**< 앞에서부터 차례로 읽음, readahead 를 크게 하고 읽은 page 는 빨리 회수 */
+    MAPPED_FILE_ADVICE_RANDOM,     /**< 임의 위치를 읽음, readahead 를 하지 않음 */
+    MAPPED_FILE_ADVICE_WILLNEED,   /**< 곧 읽을 예정, background 에서 미리 읽기 시작 */
+    MAPPED_FILE_ADVICE_DONTNEED    /**< 당분간 읽지 않음, page cache 에서 회수 가능 */
+
+} mapped_file_advice_e;
+
+/*! @struct	_MappedFile
+ *  @brief	MappedFile 모듈에 대한 구조체이다. MappedFile 모듈은 파일을 읽기 전용으로 memory 에 mapping 한다.
+ *  @note	File의 MappedFile 모듈에 대한 구조체이다. \n
+    		구조체를 사용하기 전에 NewMappedFile() 함수를 사용해야 하며 사용이 끝났을 때 DestroyMappedFile() 함수를 꼭 사용해야 한다. \n
+    		파일 내용은 처음 접근할 때 page 단위로 읽히므로 큰 파일도 생성 비용이 거의 없으며 복사 없이 사용할 수 있다.
+ *  @see	NewMappedFile
+ *  @pre	@b privilege \n
+ *          * http://tizen.org/privilege/mediastorage \n
+ *  		* http://tizen.org/privilege/externalstorage
+ */
+typedef struct _MappedFile * MappedFile;
+struct _MappedFile
+{
+    const void * (* getData) (MappedFile this_gen);
+
+    size_t (* getSize) (MappedFile this_gen);
+
+    bool (* Advise) (MappedFile this_gen, mapped_file_advice_e advice, size_t offset, size_t length);
+};
+
+typedef struct _MappedFileExtends
+{
+    struct _MappedFile file;
+    void             * data;
+    size_t             size;
+
+} MappedFileExtends;
+
+/*!	@fn			MappedFile NewMappedFile (String path, mapped_file_advice_e advice, bool hugePage)
+ *  @brief		새로운 MappedFile 객체를 생성한다.
+ *  @param[in]	path mapping 할 파일의 path
+ *  @param[in]	advice 파일 전체에 적용할 접근 방식 hint
+ *  @param[in]	hugePage @c true 이면 huge page 를 사용하도록 요청한다.
+ *  @param[out] null
+ *  @retval 	MappedFile \n
+ *              파일을 열거나 mapping 하지 못하면 @c NULL 을 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		새로운 MappedFile 객체를 생성한다. \n
+ *  			파일은 @c MAP_PRIVATE / @c PROT_READ 로 mapping 되며 fd 는 바로 닫는다. \n
+ *  			@a hugePage 는 hint 이며 kernel 이 지원하지 않으면 무시된다. \n
+ *  			빈 파일은 data 가 @c NULL, 크기가 0 인 객체가 된다.
+ *  @see 		DestroyMappedFile \n
+ *  			getMappedFileData \n
+ *  			getMappedFileSize \n
+ *  			adviseMappedFile
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ *  @warning    mapping 중에 다른 곳에서 파일을 줄이면 잘린 영역에 접근할 때 @c SIGBUS 가 발생한다. \n
+ *              사용이 끝났을 때 DestroyMappedFile() 함수를 꼭 사용해야 한다.
+ *
+ *  @code{.c}
+ *  MappedFile NewMappedFile (String path, mapped_file_advice_e advice, bool hugePage)
+ *  {
+ *      MappedFileExtends * this = (MappedFileExtends *)malloc (sizeof (MappedFileExtends));
+ *
+ *      this->file.getData = getMappedFileData;
+ *      this->file.getSize = getMappedFileSize;
+ *      this->file.Advise  = adviseMappedFile;
+ *
+ *      ...
+ *
+ *      return &this->file;
+ *  }
+ *  @endcode
+ */
+MappedFile NewMappedFile (String path, mapped_file_advice_e advice, bool hugePage);
+
+/*! @fn 		void DestroyMappedFile (MappedFile this_gen)
+ *  @brief 		생성한 MappedFile 객체를 소멸 시킨다.
+ *  @param[in] 	this_gen 소멸시킬 MappedFile 객체
+ *  @param[out] null
+ *  @retval 	void
+ *  @note 		생성한 MappedFile 객체를 소멸 시킨다. \n
+ *  			mapping 을 해제하므로 getMappedFileData() 로 받은 주소는 더 이상 사용할 수 없다.
+ *  @see 		NewMappedFile
+ */
+void DestroyMappedFile (MappedFile this_gen);
+
+/*! @fn 		const void * getMappedFileData (MappedFile this_gen)
+ *  @brief 		mapping 된 파일 내용의 시작 주소를 반환한다.
+ *  @param[in] 	this_gen 주소를 확인할 MappedFile 객체
+ *  @param[out] null
+ *  @retval 	const void * \n
+ *              빈 파일이면 @c NULL 을 반환한다.
+ *  @note 		mapping 된 파일 내용의 시작 주소를 반환한다. \n
+ *  			읽기 전용이며 값을 바꾸면 @c SIGSEGV 가 발생한다.
+ *  @see 		NewMappedFile \n
+ *  			getMappedFileSize
+ */
+const void * getMappedFileData (MappedFile this_gen);
+
+/*! @fn 		size_t getMappedFileSize (MappedFile this_gen)
+ *  @brief 		mapping 된 파일의 크기를 반환한다.
+ *  @param[in] 	this_gen 크기를 확인할 MappedFile 객체
+ *  @param[out] null
+ *  @retval 	size_t
+ *  @note 		mapping 된 파일의 크기 (byte) 를 반환한다.
+ *  @see 		NewMappedFile \n
+ *  			getMappedFileData
+ */
+size_t getMappedFileSize (MappedFile this_gen);
+
+/*! @fn 		bool adviseMappedFile (MappedFile this_gen, mapped_file_advice_e advice, size_t offset, size_t length)
+ *  @brief 		파일의 일부 영역에 접근 방식 hint 를 준다.
+ *  @param[in] 	this_gen hint 를 줄 MappedFile 객체
+ *  @param[in] 	advice 접근 방식 hint
+ *  @param[in] 	offset 영역의 시작 위치 (byte)
+ *  @param[in] 	length 영역의 크기 (byte) \n
+ *              0 이면 @a offset 부터 파일 끝까지이다.
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		파일의 일부 영역에 접근 방식 hint 를 준다. \n
+ *  			영역은 page 단위로 넓혀서 적용된다. \n
+ *  			예를 들어 다음에 읽을 영역에 @c MAPPED_FILE_ADVICE_WILLNEED 를 주면 미리 읽기가 background 에서 시작된다.
+ *  @see 		NewMappedFile
+ */
+bool adviseMappedFile (MappedFile this_gen, mapped_file_advice_e advice, size_t offset, size_t length);
+/* MappedFile */
+
+/* DiskUsage */
+/*! @struct	_DiskUsage
+ *  @brief	DiskUsage 모듈에 대한 구조체이다. DiskUsage 모듈은 directory tree 의 사용량 snapshot 을 유지한다.
+ *  @note	File의 DiskUsage 모듈에 대한 구조체이다. \n
+    		NewDiskUsage() 로 생성하면 tree 전체를 탐색하여 directory 마다 사용량을 기록하며 사용이 끝났을 때 DestroyDiskUsage() 함수를 꼭 사용해야 한다. \n
+    		Update 는 mtime 이 바뀐 directory 만 다시 읽으므로 tree 전체를 다시 탐색하는 것보다 빠르다.
+ *  @see	getDiskUsage
+ *  @pre	@b privilege \n
+ *          * http://tizen.org/privilege/mediastorage \n
+ *  		* http://tizen.org/privilege/externalstorage
+ */
+typedef struct _DiskUsage * DiskUsage;
+struct _DiskUsage
+{
+    bool (* Update) (DiskUsage this_gen);
+
+    bool (* getInfo) (DiskUsage this_gen, String path, DiskUsageInfo * info);
+};
+
+typedef struct _DiskUsageExtends
+{
+    struct _DiskUsage usage;
+    String            root;
+    int               threadCount;
+    GHashTable      * dirs;      // 상대 경로 -> directory 별 사용량
+    GMutex            lock;
+    bool              updating;
+    bool              failed;    // 마지막 탐색에서 읽지 못한 directory 가 있음
+
+} DiskUsageExtends;
+
+/*!	@fn			DiskUsage NewDiskUsage (String src, int threadCount)
+ *  @brief		새로운 DiskUsage 객체를 생성한다.
+ *  @param[in]	src 사용량을 확인할 directory 의 path
+ *  @param[in]	threadCount 탐색에 사용할 thread 수 (0 이하이면 CPU core 수)
+ *  @param[out] null
+ *  @retval 	DiskUsage \n
+ *              @a src 를 열 수 없으면 @c NULL 을 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		새로운 DiskUsage 객체를 생성하고 @a src 아래를 모두 탐색하여 첫 snapshot 을 만든다.
+ *  @see 		DestroyDiskUsage \n
+ *  			updateDiskUsage \n
+ *  			getDiskUsageInfo
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ *  @warning    사용이 끝났을 때 DestroyDiskUsage() 함수를 꼭 사용해야 한다.
+ *
+ *  @code{.c}
+ *  DiskUsage NewDiskUsage (String src, int threadCount)
+ *  {
+ *      DiskUsageExtends * this = (DiskUsageExtends *)malloc (sizeof (DiskUsageExtends));
+ *
+ *      this->usage.Update  = updateDiskUsage;
+ *      this->usage.getInfo = getDiskUsageInfo;
+ *
+ *      ...
+ *
+ *      return &this->usage;
+ *  }
+ *  @endcode
+ */
+DiskUsage NewDiskUsage (String src, int threadCount);
+
+/*! @fn 		void DestroyDiskUsage (DiskUsage this_gen)
+ *  @brief 		생성한 DiskUsage 객체를 소멸 시킨다.
+ *  @param[in] 	this_gen 소멸시킬 DiskUsage 객체
+ *  @param[out] null
+ *  @retval 	void
+ *  @note 		생성한 DiskUsage 객체를 소멸 시킨다.
+ *  @see 		NewDiskUsage
+ *  @warning    Update 가 진행중일 때 호출하면 안된다.
+ */
+void DestroyDiskUsage (DiskUsage this_gen);
+
+/*! @fn 		bool updateDiskUsage (DiskUsage this_gen)
+ *  @brief 		snapshot 을 현재 상태로 갱신한다.
+ *  @param[in] 	this_gen 갱신할 DiskUsage 객체
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		snapshot 을 현재 상태로 갱신한다. \n
+ *  			모든 directory 를 @c stat 하지만 mtime 이 바뀐 directory 만 내용을 다시 읽는다. \n
+ *  			갱신중의 getDiskUsageInfo() 는 이전 snapshot 으로 응답한다.
+ *  @see 		NewDiskUsage \n
+ *  			getDiskUsageInfo
+ *  @warning    directory 의 mtime 은 항목이 추가 / 삭제 / 이름 변경될 때만 바뀌므로 이미 있는 파일의 크기만 바뀐 경우는 반영되지 않는다. \n
+ *              이 경우에는 객체를 새로 생성해야 한다.
+ */
+bool updateDiskUsage (DiskUsage this_gen);
+
+/*! @fn 		bool getDiskUsageInfo (DiskUsage this_gen, String path, DiskUsageInfo * info)
+ *  @brief 		snapshot 에서 directory 의 사용량을 구한다.
+ *  @param[in] 	this_gen 사용량을 확인할 DiskUsage 객체
+ *  @param[in] 	path 사용량을 구할 directory 의 path \n
+ *              root 기준 상대 경로 또는 root 아래의 절대 경로이며 @c NULL 이면 root 이다.
+ *  @param[out] info 하위 항목까지 합산한 사용량
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              @a path 가 snapshot 에 없으면 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		snapshot 에서 directory 의 사용량을 하위 directory 까지 합산하여 구한다. \n
+ *  			disk 에 접근하지 않고 @a path 아래의 directory 만 확인하므로 quota 확인처럼 자주 호출해도 된다.
+ *  @see 		NewDiskUsage \n
+ *  			updateDiskUsage
+ */
+bool getDiskUsageInfo (DiskUsage this_gen, String path, DiskUsageInfo * info);
+/* DiskUsage */
+
+/* FileIndex */
+/*! @struct	_FileIndex
+ *  @brief	파일 이름 index 에 대한 구조체이다. 한 directory 아래의 모든 파일 이름을 정렬된 table 로 저장하여 디스크 탐색 없이 검색할 수 있다.
+ *  @note	File의 FileIndex 모듈에 대한 구조체이다. \n
+    		구조체를 사용하기 전에 NewFileIndex() 함수를 사용해야 하며 사용이 끝났을 때 DestroyFileIndex() 함수를 꼭 사용해야 한다. \n
+    		index 는 파일로 저장되어 mmap 으로 읽히며 inotify 로 받은 변경 사항이 검색할 때 반영된다. \n
+    		FileIndex 가 살아 있는 동안 root 아래에 대한 searchFile / searchFileParallel / searchFileForeach 는 index 로 응답한다.
+ *  @see	searchFile \n
+ *  		searchFileForeach
+ */
+typedef struct _FileIndex * FileIndex;
+struct _FileIndex
+{
+    bool (* Build) (FileIndex this_gen);
+
+    GList * (* Search) (FileIndex this_gen, String name);
+};
+
+typedef struct _FileIndexExtends
+{
+    struct _FileIndex index;
+    String            root;
+    String            path;
+    GMutex            lock;
+    GCond             built;
+    bool              building;
+    void            * map;
+    size_t            mapSize;
+    GHashTable      * added;
+    GHashTable      * removed;
+    GHashTable      * watches;
+    int               inotify;
+    int               changes;
+    bool              live;
+    bool              stale;
+
+} FileIndexExtends;
+
+/*!	@fn			FileIndex NewFileIndex (String root, String indexPath)
+ *  @brief		새로운 FileIndex 객체를 생성한다.
+ *  @param[in]	root index 할 directory 경로
+ *  @param[in]	indexPath index 를 저장할 파일 경로
+ *  @param[out] null
+ *  @retval 	FileIndex
+ *  @note 		새로운 FileIndex 객체를 생성한다. \n
+ *  			@a indexPath 에 유효한 index 가 있으면 재사용하며 그 사이 변경된 directory 가 있을 때만 다시 만든다. \n
+ *  			@a root 아래의 모든 directory 에 inotify watch 를 등록한다.
+ *  @see 		DestroyFileIndex \n
+ *  			buildFileIndex \n
+ *  			searchFileIndex
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ *  @warning    사용이 끝났을 때 DestroyFileIndex() 함수를 꼭 사용해야 한다. \n
+ *              inotify watch 수가 system 제한을 넘으면 index 는 사용되지 않으며 검색은 디스크를 직접 탐색한다.
+ *
+ *  @code{.c}
+ *  FileIndex NewFileIndex (String root, String indexPath)
+ *  {
+ *      FileIndexExtends * this = (FileIndexExtends *)malloc (sizeof (FileIndexExtends));
+ *
+ *      this->index.Build  = buildFileIndex;
+ *      this->index.Search = searchFileIndex;
+ *
+ *      ...
+ *
+ *      return &this->index;
+ *  }
+ *  @endcode
+ */
+FileIndex NewFileIndex (String root, String indexPath);
+
+/*! @fn 		void DestroyFileIndex (FileIndex this_gen)
+ *  @brief 		생성한 FileIndex 객체를 소멸 시킨다.
+ *  @param[in] 	this_gen 소멸시킬 FileIndex 객체
+ *  @param[out] null
+ *  @retval 	void
+ *  @note 		생성한 FileIndex 객체를 소멸 시킨다. \n
+ *  			저장된 index 파일은 삭제하지 않는다.
+ *  @see 		NewFileIndex
+ */
+void DestroyFileIndex (FileIndex this_gen);
+
+/*! @fn 		bool buildFileIndex (FileIndex this_gen)
+ *  @brief 		root 아래를 다시 탐색하여 index 를 새로 만든다.
+ *  @param[in] 	this_gen index 를 만들 FileIndex 객체
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		root 아래를 다시 탐색하여 index 를 새로 만든다. \n
+ *  			새 index 는 임시 파일에 쓰여진 후 fsync / rename 으로 교체된다. \n
+ *  			inotify event queue 가 넘치거나 변경 사항이 많이 쌓이면 검색할 때 자동으로 호출된다. \n
+ *  			만드는 동안 다른 경로의 검색은 막지 않으며 이 index 를 사용하는 검색만 완성될 때까지 기다린다.
+ *  @see 		NewFileIndex \n
+ *  			searchFileIndex
+ */
+bool buildFileIndex (FileIndex this_gen);
+
+/*! @fn 		GList * searchFileIndex (FileIndex this_gen, String name)
+ *  @brief 		index 에서 @a name 과 이름이 같은 파일을 찾는다.
+ *  @param[in] 	this_gen 검색할 FileIndex 객체
+ *  @param[in] 	name 찾을 파일 이름
+ *  @param[out] null
+ *  @retval 	GList * \n
+ *              찾은 파일들의 절대 경로 리스트를 반환한다. \n
+ *              index 를 사용할 수 없으면 @c NULL 을 반환한다.
+ *  @note 		index 에서 @a name 과 이름이 같은 파일을 찾는다. \n
+ *  			검색 전에 쌓인 inotify event 를 반영한다.
+ *  @see 		NewFileIndex \n
+ *  			buildFileIndex \n
+ *  			deleteSearchedList
+ *  @warning    검색 결과 리스트는 사용이 끝났을 때 deleteSearchedList() 함수로 삭제해야 한다.
+ */
+GList * searchFileIndex (FileIndex this_gen, String name);
+/* FileIndex */
+
+/* FileWatcher */
+/*! @enum   file_change_e
+ *  @brief  FileWatcher 가 전달하는 변경 종류이다. 하나의 FileChange 에 여러 종류가 OR 되어 전달될 수 있다.
+ */
+typedef enum
+{
+    FILE_CHANGE_CREATED    = 0x01, /**< 생성 */
+    FILE_CHANGE_DELETED    = 0x02, /**< 삭제 */
+    FILE_CHANGE_MODIFIED   = 0x04, /**< 내용 변경 */
+    FILE_CHANGE_ATTRIBUTE  = 0x08, /**< 권한 / 시간 등 속성 변경 */
+    FILE_CHANGE_MOVED_FROM = 0x10, /**< 다른 경로로 이동됨 */
+    FILE_CHANGE_MOVED_TO   = 0x20, /**< 다른 경로에서 이동되어 옴 */
+    FILE_CHANGE_OVERFLOW   = 0x40  /**< 변경 사항을 놓쳤으므로 다시 탐색해야 함 */
+
+} file_change_e;
+
+/*! @struct	FileChange
+ *  @brief	FileWatcher 가 전달하는 하나의 경로에 대한 변경 사항이다.
+ *  @note	@a path 는 @c FILE_CHANGE_OVERFLOW 가 inotify event queue 가 넘쳐서 발생한 경우 @c NULL 이다.
+ */
+typedef struct _FileChange
+{
+    String path;
+    int    events;      // file_change_e 의 OR
+    bool   isDirectory;
+
+} FileChange;
+
+typedef void (* FileWatcherCallback) (FileChange * changes, int count, void * user_data);
+
+/*! @struct	_FileWatcher
+ *  @brief	FileWatcher 모듈에 대한 구조체이다. FileWatcher 모듈은 inotify 로 파일 / directory 의 변경을 감시한다.
+ *  @note	File의 FileWatcher 모듈에 대한 구조체이다. \n
+    		구조체를 사용하기 전에 NewFileWatcher() 함수를 사용해야 하며 사용이 끝났을 때 DestroyFileWatcher() 함수를 꼭 사용해야 한다. \n
+    		짧은 시간 동안 발생한 event 들은 경로별로 합쳐져 한번의 callback 으로 전달된다.
+ *  @see	[Linux inotify](http://man7.org/linux/man-pages/man7/inotify.7.html)
+ */
+typedef struct _FileWatcher * FileWatcher;
+struct _FileWatcher
+{
+    bool (* addWatch) (FileWatcher this_gen, String path, bool recursive);
+
+    bool (* removeWatch) (FileWatcher this_gen, String path);
+
+    bool (* setLimit) (FileWatcher this_gen, int maxWatches);
+
+    bool (* addCallback) (FileWatcher this_gen, FileWatcherCallback callback, int latency, void * data);
+
+    bool (* detachCallback) (FileWatcher this_gen);
+
+    bool (* On) (FileWatcher this_gen);
+
+    bool (* Off) (FileWatcher this_gen);
+};
+
+typedef struct _FileWatcherExtends
+{
+    struct _FileWatcher watcher;
+    GMutex              lock;
+    GHashTable        * watches; // wd -> 감시 정보
+    GHashTable        * paths;   // 경로 -> 감시 정보
+    GThread           * thread;
+    FileWatcherCallback callback;
+    void              * user_data;
+    int                 latency;
+    int                 limit;
+    int                 inotify;
+    int                 wakeup[2];
+    bool                activated;
+
+} FileWatcherExtends;
+
+/*!	@fn			FileWatcher NewFileWatcher (void)
+ *  @brief		새로운 FileWatcher 객체를 생성한다.
+ *  @param[in]	void
+ *  @param[out] null
+ *  @retval 	FileWatcher
+ *  @note 		새로운 FileWatcher 객체를 생성한다. \n
+ *  			FileWatcher 객체를 사용하기 전에 반드시 호출해야 한다.
+ *  @see 		DestroyFileWatcher \n
+ *  			addFileWatch \n
+ *  			removeFileWatch \n
+ *  			setFileWatchLimit \n
+ *  			addFileWatcherCallback \n
+ *  			detachFileWatcherCallback \n
+ *  			FileWatcherOn \n
+ *  			FileWatcherOff
+ *  @warning    사용이 끝났을 때 DestroyFileWatcher() 함수를 꼭 사용해야 한다.
+ *
+ *  @code{.c}
+ *  FileWatcher NewFileWatcher (void)
+ *  {
+ *      FileWatcherExtends * this = (FileWatcherExtends *)malloc (sizeof (FileWatcherExtends));
+ *
+ *      this->watcher.addWatch       = addFileWatch;
+ *      this->watcher.removeWatch    = removeFileWatch;
+ *      this->watcher.setLimit       = setFileWatchLimit;
+ *      this->watcher.addCallback    = addFileWatcherCallback;
+ *      this->watcher.detachCallback = detachFileWatcherCallback;
+ *      this->watcher.On             = FileWatcherOn;
+ *      this->watcher.Off            = FileWatcherOff;
+ *
+ *      ...
+ *
+ *      return &this->watcher;
+ *  }
+ *  @endcode
+ */
+FileWatcher NewFileWatcher (void);
+
+/*! @fn 		void DestroyFileWatcher (FileWatcher this_gen)
+ *  @brief 		생성한 FileWatcher 객체를 소멸 시킨다.
+ *  @param[in] 	this_gen 소멸시킬 FileWatcher 객체
+ *  @param[out] null
+ *  @retval 	void
+ *  @note 		생성한 FileWatcher 객체를 소멸 시킨다. \n
+ *  			감시중이면 FileWatcherOff() 를 먼저 수행한다.
+ *  @see 		NewFileWatcher
+ */
+void DestroyFileWatcher (FileWatcher this_gen);
+
+/*! @fn 		bool addFileWatch (FileWatcher this_gen, String path, bool recursive)
+ *  @brief 		감시할 경로를 추가한다.
+ *  @param[in] 	this_gen 경로를 추가할 FileWatcher 객체
+ *  @param[in] 	path 감시할 파일 / directory 경로
+ *  @param[in] 	recursive @c true 이면 하위 directory 도 모두 감시하며 새로 생긴 directory 도 자동으로 감시한다.
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		감시할 경로를 추가한다. \n
+ *  			directory 하나당 하나의 watch 를 사용하며 setFileWatchLimit() 로 정한 수를 넘으면 실패하고 이번 호출이 새로 추가한 watch 들만 되돌린다. \n
+ *  			감시중인 directory 가 다른 곳으로 옮겨지면 그 경로에 대한 감시는 해제된다. \n
+ *  			감시중에 새로 생긴 directory 때문에 수를 넘으면 그 directory 에 대해 @c FILE_CHANGE_OVERFLOW 를 전달한다.
+ *  @see 		removeFileWatch \n
+ *  			setFileWatchLimit
+ */
+bool addFileWatch (FileWatcher this_gen, String path, bool recursive);
+
+/*! @fn 		bool removeFileWatch (FileWatcher this_gen, String path)
+ *  @brief 		경로와 그 하위 경로들에 대한 감시를 해제한다.
+ *  @param[in] 	this_gen 경로를 삭제할 FileWatcher 객체
+ *  @param[in] 	path 감시를 해제할 경로
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		경로와 그 하위 경로들에 대한 감시를 해제한다.
+ *  @see 		addFileWatch
+ */
+bool removeFileWatch (FileWatcher this_gen, String path);
+
+/*! @fn 		bool setFileWatchLimit (FileWatcher this_gen, int maxWatches)
+ *  @brief 		FileWatcher 가 사용할 수 있는 최대 watch 수를 정한다.
+ *  @param[in] 	this_gen 설정할 FileWatcher 객체
+ *  @param[in] 	maxWatches 최대 watch 수 (기본값 8192)
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		FileWatcher 가 사용할 수 있는 최대 watch 수를 정한다. \n
+ *  			inotify watch 는 사용자 단위로 system 전체에서 제한되므로 다른 module 과 나누어 써야 한다. \n
+ *  			이미 추가된 watch 는 해제하지 않는다.
+ *  @see 		addFileWatch
+ */
+bool setFileWatchLimit (FileWatcher this_gen, int maxWatches);
+
+/*! @fn 		bool addFileWatcherCallback (FileWatcher this_gen, FileWatcherCallback callback, int latency, void * data)
+ *  @brief 		변경 사항을 전달 받을 callback 함수를 등록한다.
+ *  @param[in] 	this_gen callback 함수를 등록할 FileWatcher 객체
+ *  @param[in] 	callback 등록할 callback 함수
+ *  @param[in] 	latency event 를 모을 시간 (ms) \n
+ *              마지막 event 후 @a latency 동안 새 event 가 없거나 첫 event 후 4 * @a latency 가 지나면 callback 이 호출된다.
+ *  @param[in] 	data callback 함수에 전달될 사용자 data 주소
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		변경 사항을 전달 받을 callback 함수를 등록한다. \n
+ *  			같은 경로에 대한 event 들은 하나의 FileChange 로 합쳐지며 발생 순서대로 전달된다. \n
+ *  			@a changes 는 callback 이 반환된 후 해제된다.
+ *  @see 		detachFileWatcherCallback \n
+ *  			FileWatcherOn
+ *  @warning    callback 은 감시 thread 에서 호출된다. callback 안에서 FileWatcherOff() / DestroyFileWatcher() 를 호출하면 안된다.
+ */
+bool addFileWatcherCallback (FileWatcher this_gen, FileWatcherCallback callback, int latency, void * data);
+
+/*! @fn 		bool detachFileWatcherCallback (FileWatcher this_gen)
+ *  @brief 		등록한 callback 함수를 삭제한다.
+ *  @param[in] 	this_gen callback 함수를 삭제할 FileWatcher 객체
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		등록한 callback 함수를 삭제한다. \n
+ *  			감시중에는 삭제할 수 없으므로 FileWatcherOff() 를 먼저 호출해야 한다.
+ *  @see 		addFileWatcherCallback
  */
-bool deleteFile (String src);
+bool detachFileWatcherCallback (FileWatcher this_gen);
 
-/*! @fn 		bool copyFile (String src, String dst);
- *  @brief 		해당 파일을 복사한다.
- *  @param[in] 	src 복사할 파일의 path
- *  @param[in] 	dst 붙여넣을 위치의 파일의 path
+/*! @fn 		bool FileWatcherOn (FileWatcher this_gen)
+ *  @brief 		감시 thread 를 시작한다.
+ *  @param[in] 	this_gen 시작할 FileWatcher 객체
  *  @param[out] null
  *  @retval 	bool \n
  *              함수의 성공 여부를 반환한다. \n
  *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
- *  @note 		해당 파일을 복사한다. \n
- *  @see 		NewFile \n
- *  			DestroyFile \n
- *  			deleteFile \n
- *  			moveFile \n
- *  			searchFile \n
- *  			deleteSearchedList
- *  @pre        @b privilege \n
- *              * http://tizen.org/privilege/mediastorage \n
- *              * http://tizen.org/privilege/externalstorage
+ *  @note 		감시 thread 를 시작한다. \n
+ *  			addFileWatcherCallback() 으로 callback 함수를 먼저 등록해야 한다.
+ *  @see 		FileWatcherOff
  */
+bool FileWatcherOn (FileWatcher this_gen);
 
-bool copyFile (String src, String dst);
-/*! @fn 		bool moveFile (String src, String dst);
- *  @brief 		해당 파일을 이동 시킨다.
- *  @param[in] 	src 복사할 파일의 path
- *  @param[in] 	dst 이동시킬 위치의 파일의 path
+/*! @fn 		bool FileWatcherOff (FileWatcher this_gen)
+ *  @brief 		감시 thread 를 멈춘다.
+ *  @param[in] 	this_gen 멈출 FileWatcher 객체
  *  @param[out] null
  *  @retval 	bool \n
  *              함수의 성공 여부를 반환한다. \n
  *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
- *  @note 		해당 파일을 이동 시킨다. \n
- *  @see 		NewFile \n
- *  			DestroyFile \n
- *  			deleteFile \n
- *  			copyFile \n
- *  			searchFile \n
- *  			deleteSearchedList
- *  @pre        @b privilege \n
- *              * http://tizen.org/privilege/mediastorage \n
- *              * http://tizen.org/privilege/externalstorage
+ *  @note 		감시 thread 를 멈춘다. \n
+ *  			모아둔 변경 사항은 멈추기 전에 callback 으로 전달된다. 멈춘 동안의 event 는 kernel 에 쌓였다가 다시 시작하면 전달된다.
+ *  @see 		FileWatcherOn
  */
-bool moveFile (String src, String dst);
+bool FileWatcherOff (FileWatcher this_gen);
+/* FileWatcher */
+
+/* PlayerPool */
+/*! @struct	_PlayerPool
+ *  @brief	PlayerPool 모듈에 대한 구조체이다. PlayerPool 모듈은 곧 재생할 URI 의 player 를 미리 prepare 해 둔다.
+ *  @note	File의 PlayerPool 모듈에 대한 구조체이다. \n
+    		구조체를 사용하기 전에 NewPlayerPool() 함수를 사용해야 하며 사용이 끝났을 때 DestroyPlayerPool() 함수를 꼭 사용해야 한다. \n
+    		Preload 로 playlist 의 다음 URI 들을 넘기면 background thread 가 차례로 player 를 만들어 prepare 한다. \n
+    		setVideoPlayerPool() / setAudioPlayerPool() 로 지정된 Video / Audio 객체는 pool 에 준비된 URI 를 설정할 때 그 player 를 넘겨받으므로 Play 에서는 player_start 만 한다. \n
+    		player 수나 memory 사용량이 한도를 넘으면 마지막 Preload 목록에 없는 player 부터 오래된 순으로 버린다.
+ *  @see	NewVideo \n
+ *  		NewAudio
+ *  @pre	@b privilege \n
+ *          * http://tizen.org/privilege/display \n
+ *          * http://tizen.org/privilege/mediastorage \n
+ *          * http://tizen.org/privilege/externalstorage \n
+ *          * http://tizen.org/privilege/internet
+ */
+typedef struct _PlayerPool * PlayerPool;
+struct _PlayerPool
+{
+    bool (* Preload) (PlayerPool this_gen, String * uris, int count);
 
-/*! @fn 		GList * searchFile (String src, String dst)
- *  @brief 		파일을 검색한다.
- *  @param[in] 	src 검색을 수행 할 위치의 path
- *  @param[in] 	dst 검색 할 파일의 이름
+    bool (* setObject) (PlayerPool this_gen, Evas_Object * EvasObject);
+};
+
+typedef struct _PlayerPoolExtends
+{
+    struct _PlayerPool pool;
+    int                maxPlayers;
+    size_t             budget;          // prepare 된 player 들이 사용할 수 있는 memory (byte)
+    size_t             cost;            // player 하나가 사용하는 것으로 보는 memory (byte)
+    GQueue             entries;         // head 가 가장 최근에 사용한 player
+    GQueue             pending;         // prepare 할 URI
+    String             preparing;       // 지금 prepare 중인 URI
+    bool               preparingWanted; // preparing 이 마지막 Preload 목록에 있음
+    Evas_Object      * EvasObject;
+    GThread          * thread;
+    GMutex             lock;
+    GCond              cond;
+    bool               stop;
+
+} PlayerPoolExtends;
+
+/*!	@fn			PlayerPool NewPlayerPool (int maxPlayers, size_t memoryBudget, size_t playerCost)
+ *  @brief		새로운 PlayerPool 객체를 생성한다.
+ *  @param[in]	maxPlayers 미리 prepare 해 둘 player 의 최대 수 (0 이하이면 2)
+ *  @param[in]	memoryBudget prepare 된 player 들이 사용할 수 있는 memory (byte, 0 이면 제한 없음)
+ *  @param[in]	playerCost prepare 된 player 하나가 사용하는 것으로 볼 memory (byte, 0 이면 8 MB)
  *  @param[out] null
- *  @retval 	GList*
- *  @note 		@a src 폴더 내부에서 @a dst 키워드를 가진 파일을 검색한다. \n
- *  @see 		NewFile \n
- *  			DestroyFile \n
- *  			deleteFile \n
- *  			copyFile \n
- *  			moveFile \n
- *  			deleteSearchedList
- *  @pre        @b privilege \n
- *              * http://tizen.org/privilege/mediastorage \n
- *              * http://tizen.org/privilege/externalstorage
+ *  @retval 	PlayerPool
+ *  @note 		새로운 PlayerPool 객체를 생성한다. \n
+ *  			player 의 실제 memory 사용량은 재지 않으며 (decoder 가 다른 process 에 있을 수도 있다.) \n
+ *  			prepare 된 player 수 x @a playerCost 가 @a memoryBudget 을 넘지 않게 한다.
+ *  @see 		DestroyPlayerPool \n
+ *  			preloadPlayerPool \n
+ *  			setPlayerPoolObject
+ *  @warning    사용이 끝났을 때 DestroyPlayerPool() 함수를 꼭 사용해야 한다.
+ *
+ *  @code{.c}
+ *  PlayerPool NewPlayerPool (int maxPlayers, size_t memoryBudget, size_t playerCost)
+ *  {
+ *      PlayerPoolExtends * this = (PlayerPoolExtends *)malloc (sizeof (PlayerPoolExtends));
+ *
+ *      this->pool.Preload   = preloadPlayerPool;
+ *      this->pool.setObject = setPlayerPoolObject;
+ *
+ *      ...
+ *
+ *      return &this->pool;
+ *  }
+ *  @endcode
  */
-GList * searchFile (String src, String dst);
+PlayerPool NewPlayerPool (int maxPlayers, size_t memoryBudget, size_t playerCost);
 
-/*! @fn 		void deleteSearchedList (GList * searchedList)
- *  @brief 		파일 검색 결과 리스트를 삭제한다.
- *  @param[in] 	searchedList 삭제할 파일 검색 결과 리스트
+/*! @fn 		void DestroyPlayerPool (PlayerPool this_gen)
+ *  @brief 		생성한 PlayerPool 객체를 소멸 시킨다.
+ *  @param[in] 	this_gen 소멸시킬 PlayerPool 객체
  *  @param[out] null
  *  @retval 	void
- *  @note 		파일 검색 결과 리스트를 삭제한다. \n
- *  @see 		NewFile \n
- *  			DestroyFile \n
- *  			deleteFile \n
- *  			copyFile \n
- *  			moveFile \n
- *  			searchFile
- *  @pre        @b privilege \n
- *              * http://tizen.org/privilege/mediastorage \n
- *              * http://tizen.org/privilege/externalstorage
+ *  @note 		생성한 PlayerPool 객체를 소멸 시킨다. \n
+ *  			지금 prepare 중인 player 를 기다린 뒤 남아 있는 player 를 모두 unprepare / destroy 한다. \n
+ *  			이미 Video / Audio 객체로 넘어간 player 는 해당 객체가 소멸시킨다.
+ *  @see 		NewPlayerPool
+ *  @warning    이 pool 을 지정한 Video / Audio 객체보다 나중에 소멸시켜야 한다.
  */
-void deleteSearchedList (GList * searchedList);
-/* File */
+void DestroyPlayerPool (PlayerPool this_gen);
+
+/*! @fn 		bool preloadPlayerPool (PlayerPool this_gen, String * uris, int count)
+ *  @brief 		곧 재생할 URI 들의 player 를 background 에서 prepare 한다.
+ *  @param[in] 	this_gen PlayerPool 객체
+ *  @param[in] 	uris 재생할 순서대로 정렬된 URI 배열
+ *  @param[in] 	count @a uris 의 크기
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		@a uris 를 복사하여 이전 Preload 목록을 대체하고 바로 반환한다. \n
+ *  			앞에서부터 최대 maxPlayers 개만 prepare 하며 이미 준비된 URI 는 다시 prepare 하지 않는다. \n
+ *  			playlist 에서 현재 곡이 바뀔 때마다 다음 URI 들로 다시 호출하면 된다.
+ *  @see 		NewPlayerPool \n
+ *  			setVideoPlayerPool \n
+ *  			setAudioPlayerPool
+ */
+bool preloadPlayerPool (PlayerPool this_gen, String * uris, int count);
 
+/*! @fn 		bool setPlayerPoolObject (PlayerPool this_gen, Evas_Object * EvasObject)
+ *  @brief 		pool 에서 꺼낸 player 의 Evas Object 를 설정한다.
+ *  @param[in] 	this_gen PlayerPool 객체
+ *  @param[in] 	EvasObject 동영상을 출력할 Evas Object (@c NULL 이면 출력하지 않는다.)
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		Evas Object 는 main loop 에서만 다룰 수 있으므로 preload thread 는 display 없이 prepare 한다. \n
+ *  			Evas Object 가 설정되지 않은 Video 객체가 pool 의 player 를 넘겨받으면 setVideoURI() 를 호출한 thread 에서 이 Evas Object 로 display 를 설정한다. \n
+ *  			이미 prepare 된 player 가 display 변경을 받지 않으면 그 thread 에서 unprepare 후 display 를 설정하고 다시 prepare 하므로 setVideoURI() 는 main loop 에서 호출해야 한다.
+ *  @see 		NewPlayerPool \n
+ *  			setEvasObject
+ */
+bool setPlayerPoolObject (PlayerPool this_gen, Evas_Object * EvasObject);
+/* PlayerPool */
 
 /* Video */
+/*! @def	MEDIA_METADATA_COUNT
+ *  @brief	Video / Audio 객체가 보관하는 meta data 항목 수이다.
+ *  @note	@c METADATA_DURATION 부터 @c METADATA_ROTATE 까지의 항목을 처음 요청할 때 한번에 꺼내 보관한다.
+ */
+#define MEDIA_METADATA_COUNT (METADATA_ROTATE + 1)
+
 /*! @struct	_Video
  *  @brief	Video 모듈에 대한 구조체이다. Video 모듈은 다양한 방식으로 동영상 파일을 제어 할 수 있다.
  *  @note	File의 Video 모듈에 대한 구조체이다. \n
@@ -290,6 +1979,8 @@ struct _Video
 
     bool (* setObject) (Video this_gen, Evas_Object * EvasObject);
 
+    bool (* setPool) (Video this_gen, PlayerPool pool);
+
 };
 
 typedef struct _VideoExtends
@@ -299,6 +1990,9 @@ typedef struct _VideoExtends
     player_h             player_handle;
     metadata_extractor_h videoMetadataHandle;
     String               uri;
+    PlayerPool           pool;
+    String               metadata[MEDIA_METADATA_COUNT]; // 처음 getVideoInfo() 를 호출할 때 채운다.
+    bool                 metadataLoaded;
 
 } VideoExtends;
 
@@ -315,7 +2009,8 @@ typedef struct _VideoExtends
  *  			stopVideo \n
  *  			getVideoInfo \n
  *  			setVideoURI \n
- *  			setEvasObject
+ *  			setEvasObject \n
+ *  			setVideoPlayerPool
  *  @pre    	@b privilege \n
  *              * http://tizen.org/privilege/display \n
  *              * http://tizen.org/privilege/mediastorage \n
@@ -334,11 +2029,15 @@ Video NewVideo (void)
     this->video.Stop      = stopVideo;
     this->video.setURI    = setVideoURI;
     this->video.setObject = setEvasObject;
+    this->video.setPool   = setVideoPlayerPool;
 
     this->videoMetadataHandle = NULL;
     this->player_handle       = NULL;
     this->uri                 = NULL;
     this->EvasObject          = NULL;
+    this->pool                = NULL;
+    this->metadataLoaded      = false;
+    memset (this->metadata, 0, sizeof (this->metadata));
 
     player_create (&this->player_handle);
     metadata_extractor_create (&this->videoMetadataHandle);
@@ -440,6 +2139,7 @@ bool stopVideo (Video this_gen);
  *  @param[out] null
  *  @retval 	String
  *  @note 		동영상 파일의 meta data를 가져온다. \n
+ *  			URI 를 설정한 뒤 처음 호출할 때 모든 항목을 한번에 꺼내 객체에 보관하며 이후에는 파일을 다시 읽지 않는다.
  *  @see 		NewVideo \n
  *  			DestroyVideo \n
  *  			playVideo \n
@@ -465,6 +2165,7 @@ String getVideoInfo (Video this_gen, metadata_extractor_attr_e element);
  *              함수의 성공 여부를 반환한다. \n
  *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
  *  @note 		생성한 Video 객체의 URI를 설정한다. \n
+ *  			setVideoPlayerPool() 로 지정한 pool 에 prepare 된 player 가 있으면 그 player 로 교체한다.
  *  @see 		NewVideo \n
  *  			DestroyVideo \n
  *  			playVideo \n
@@ -502,6 +2203,22 @@ bool setVideoURI (Video this_gen, String URI);
  *              * http://tizen.org/privilege/externalstorage
  */
 bool setEvasObject (Video this_gen, Evas_Object * EvasObject);
+
+/*! @fn 		bool setVideoPlayerPool (Video this_gen, PlayerPool pool)
+ *  @brief 		setVideoURI() 가 prepare 된 player 를 찾을 PlayerPool 을 지정한다.
+ *  @param[in] 	this_gen Video 객체
+ *  @param[in] 	pool 사용할 PlayerPool 객체 (@c NULL 이면 pool 을 사용하지 않는다.)
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		setVideoURI() 가 prepare 된 player 를 찾을 PlayerPool 을 지정한다. \n
+ *  			pool 의 player 를 넘겨받으면 playVideo() 는 prepare 없이 바로 재생을 시작한다.
+ *  @see 		setVideoURI \n
+ *  			NewPlayerPool
+ *  @warning    @a pool 은 Video 객체보다 나중에 소멸시켜야 한다.
+ */
+bool setVideoPlayerPool (Video this_gen, PlayerPool pool);
 /* Video */
 
 
@@ -528,6 +2245,8 @@ struct _Audio
     String (* getInfo) (Audio this_gen, metadata_extractor_attr_e metadataKey);
 
     bool (* setURI) (Audio this_gen, String uri);
+
+    bool (* setPool) (Audio this_gen, PlayerPool pool);
 };
 
 typedef struct _AudioExtends
@@ -536,6 +2255,9 @@ typedef struct _AudioExtends
     player_h             player_handle;
     metadata_extractor_h audioMetadataHandle;
     String               uri;
+    PlayerPool           pool;
+    String               metadata[MEDIA_METADATA_COUNT]; // 처음 getAudioInfo() 를 호출할 때 채운다.
+    bool                 metadataLoaded;
 
 } AudioExtends;
 
@@ -551,7 +2273,8 @@ typedef struct _AudioExtends
  *  			pauseAudio \n
  *  			stopAudio \n
  *  			getAudioInfo \n
- *  			setAudioURI
+ *  			setAudioURI \n
+ *  			setAudioPlayerPool
  *  @pre    	@b privilege \n
  *              * http://tizen.org/privilege/mediastorage \n
  *              * http://tizen.org/privilege/externalstorage \n
@@ -569,10 +2292,14 @@ Audio NewAudio ()
     this->audio.Play    = playAudio;
     this->audio.Stop    = stopAudio;
     this->audio.setURI  = setAudioURI;
+    this->audio.setPool = setAudioPlayerPool;
 
     this->uri                 = NULL;
     this->player_handle       = NULL;
     this->audioMetadataHandle = NULL;
+    this->pool                = NULL;
+    this->metadataLoaded      = false;
+    memset (this->metadata, 0, sizeof (this->metadata));
 
     player_create (&this->player_handle);
     metadata_extractor_create (&this->audioMetadataHandle);
@@ -671,6 +2398,7 @@ bool stopAudio (Audio this_gen);
  *  @param[out] null
  *  @retval 	String
  *  @note 		음악 파일의 meta data를 가져온다. \n
+ *  			URI 를 설정한 뒤 처음 호출할 때 모든 항목을 한번에 꺼내 객체에 보관하며 이후에는 파일을 다시 읽지 않는다.
  *  @see 		NewAudio \n
  *  			DestroyAudio \n
  *  			playAudio \n
@@ -695,6 +2423,7 @@ String getAudioInfo (Audio this_gen, metadata_extractor_attr_e metadataKey);
  *              함수의 성공 여부를 반환한다. \n
  *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
  *  @note 		생성한 Audio 객체의 URI를 설정한다. \n
+ *  			setAudioPlayerPool() 로 지정한 pool 에 prepare 된 player 가 있으면 그 player 로 교체한다.
  *  @see 		NewAudio \n
  *  			DestroyAudio \n
  *  			playAudio \n
@@ -708,10 +2437,300 @@ String getAudioInfo (Audio this_gen, metadata_extractor_attr_e metadataKey);
  *  @warning    playAudio() , pauseAudio() , stopAudio() , getAudioInfo() 함수를 사용하기 전에 미리 URI를 설정해야 한다.
  */
 bool setAudioURI (Audio this_gen, String uri);
+
+/*! @fn 		bool setAudioPlayerPool (Audio this_gen, PlayerPool pool)
+ *  @brief 		setAudioURI() 가 prepare 된 player 를 찾을 PlayerPool 을 지정한다.
+ *  @param[in] 	this_gen Audio 객체
+ *  @param[in] 	pool 사용할 PlayerPool 객체 (@c NULL 이면 pool 을 사용하지 않는다.)
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		setAudioURI() 가 prepare 된 player 를 찾을 PlayerPool 을 지정한다. \n
+ *  			pool 의 player 를 넘겨받으면 playAudio() 는 prepare 없이 바로 재생을 시작한다.
+ *  @see 		setAudioURI \n
+ *  			NewPlayerPool
+ *  @warning    @a pool 은 Audio 객체보다 나중에 소멸시켜야 한다.
+ */
+bool setAudioPlayerPool (Audio this_gen, PlayerPool pool);
 /* Audio */
 
+/* AudioPlaylist */
+/*! @struct	_AudioPlaylist
+ *  @brief	AudioPlaylist 모듈에 대한 구조체이다. AudioPlaylist 모듈은 여러 음악 파일을 곡 사이의 끊김 없이 차례로 재생한다.
+ *  @note	File의 AudioPlaylist 모듈에 대한 구조체이다. \n
+    		구조체를 사용하기 전에 NewAudioPlaylist() 함수를 사용해야 하며 사용이 끝났을 때 DestroyAudioPlaylist() 함수를 꼭 사용해야 한다. \n
+    		두 player 를 번갈아 사용하여 한 곡을 재생하는 동안 다른 player 에 다음 곡을 prepare 해 둔다. \n
+    		곡이 끝나면 준비된 player 를 바로 시작하므로 setAudioURI() 로 곡을 바꿀 때의 끊김과 prepare 지연이 없다.
+ *  @see	NewAudio
+ *  @pre	@b privilege \n
+ *          * http://tizen.org/privilege/mediastorage \n
+ *          * http://tizen.org/privilege/externalstorage \n
+ *          * http://tizen.org/privilege/internet
+ */
+typedef struct _AudioPlaylist * AudioPlaylist;
+struct _AudioPlaylist
+{
+    bool (* setList) (AudioPlaylist this_gen, String * uris, int count);
+
+    bool (* Play) (AudioPlaylist this_gen);
+
+    bool (* Pause) (AudioPlaylist this_gen);
+
+    bool (* Stop) (AudioPlaylist this_gen);
+
+    bool (* Next) (AudioPlaylist this_gen);
+
+    int (* getIndex) (AudioPlaylist this_gen);
+
+    bool (* setRepeat) (AudioPlaylist this_gen, bool repeat);
+};
+
+typedef struct _AudioPlaylistExtends
+{
+    struct _AudioPlaylist playlist;
+    player_h              players[2];   // 번갈아 사용하는 player
+    int                   prepared[2];  // player 에 prepare 된 곡의 index, 없으면 -1
+    int                   current;      // 재생중인 player 의 index
+    String              * uris;
+    bool                * broken;       // prepare 에 실패한 곡
+    int                   count;
+    int                   index;        // 재생중인 곡
+    unsigned int          version;      // 목록을 바꿀 때마다 증가
+    bool                  repeat;
+    bool                  playing;
+    bool                  startPending; // 현재 곡이 준비되는 대로 시작해야 함
+    GThread             * thread;
+    GMutex                lock;
+    GCond                 cond;
+    bool                  stop;
+
+} AudioPlaylistExtends;
+
+/*!	@fn			AudioPlaylist NewAudioPlaylist (void)
+ *  @brief		새로운 AudioPlaylist 객체를 생성한다.
+ *  @param[in]	void
+ *  @param[out] null
+ *  @retval 	AudioPlaylist \n
+ *              player 를 만들 수 없으면 @c NULL 을 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		새로운 AudioPlaylist 객체를 생성한다. \n
+ *  			player 두개와 prepare 를 담당하는 thread 하나를 만든다.
+ *  @see 		DestroyAudioPlaylist \n
+ *  			setAudioPlaylist \n
+ *  			playAudioPlaylist \n
+ *  			pauseAudioPlaylist \n
+ *  			stopAudioPlaylist \n
+ *  			nextAudioPlaylist \n
+ *  			getAudioPlaylistIndex \n
+ *  			setAudioPlaylistRepeat
+ *  @warning    사용이 끝났을 때 DestroyAudioPlaylist() 함수를 꼭 사용해야 한다.
+ *
+ *  @code{.c}
+ *  AudioPlaylist NewAudioPlaylist (void)
+ *  {
+ *      AudioPlaylistExtends * this = (AudioPlaylistExtends *)malloc (sizeof (AudioPlaylistExtends));
+ *
+ *      this->playlist.setList   = setAudioPlaylist;
+ *      this->playlist.Play      = playAudioPlaylist;
+ *      this->playlist.Pause     = pauseAudioPlaylist;
+ *      this->playlist.Stop      = stopAudioPlaylist;
+ *      this->playlist.Next      = nextAudioPlaylist;
+ *      this->playlist.getIndex  = getAudioPlaylistIndex;
+ *      this->playlist.setRepeat = setAudioPlaylistRepeat;
+ *
+ *      ...
+ *
+ *      return &this->playlist;
+ *  }
+ *  @endcode
+ */
+AudioPlaylist NewAudioPlaylist (void);
+
+/*! @fn 		void DestroyAudioPlaylist (AudioPlaylist this_gen)
+ *  @brief 		생성한 AudioPlaylist 객체를 소멸 시킨다.
+ *  @param[in] 	this_gen 소멸시킬 AudioPlaylist 객체
+ *  @param[out] null
+ *  @retval 	void
+ *  @note 		생성한 AudioPlaylist 객체를 소멸 시킨다. \n
+ *  			진행중인 prepare 를 기다린 뒤 두 player 를 소멸시킨다.
+ *  @see 		NewAudioPlaylist
+ */
+void DestroyAudioPlaylist (AudioPlaylist this_gen);
+
+/*! @fn 		bool setAudioPlaylist (AudioPlaylist this_gen, String * uris, int count)
+ *  @brief 		재생할 곡의 목록을 설정한다.
+ *  @param[in] 	this_gen AudioPlaylist 객체
+ *  @param[in] 	uris 재생할 순서대로 정렬된 URI 배열
+ *  @param[in] 	count @a uris 의 크기
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		@a uris 를 복사하여 목록을 대체하고 재생을 멈춘다. \n
+ *  			첫 곡과 다음 곡의 prepare 를 background 에서 바로 시작하므로 잠시 뒤의 playAudioPlaylist() 는 지연 없이 시작한다.
+ *  @see 		NewAudioPlaylist \n
+ *  			playAudioPlaylist
+ */
+bool setAudioPlaylist (AudioPlaylist this_gen, String * uris, int count);
+
+/*! @fn 		bool playAudioPlaylist (AudioPlaylist this_gen)
+ *  @brief 		현재 곡부터 재생한다.
+ *  @param[in] 	this_gen AudioPlaylist 객체
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		현재 곡부터 재생하며 일시 정지된 상태이면 이어서 재생한다. \n
+ *  			현재 곡이 아직 준비중이면 준비가 끝나는 대로 재생을 시작한다. \n
+ *  			prepare 에 실패한 곡은 건너뛴다.
+ *  @see 		pauseAudioPlaylist \n
+ *  			stopAudioPlaylist
+ */
+bool playAudioPlaylist (AudioPlaylist this_gen);
+
+/*! @fn 		bool pauseAudioPlaylist (AudioPlaylist this_gen)
+ *  @brief 		재생중인 곡을 일시 정지한다.
+ *  @param[in] 	this_gen AudioPlaylist 객체
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		재생중인 곡을 일시 정지한다. \n
+ *  @see 		playAudioPlaylist
+ */
+bool pauseAudioPlaylist (AudioPlaylist this_gen);
+
+/*! @fn 		bool stopAudioPlaylist (AudioPlaylist this_gen)
+ *  @brief 		재생중인 곡을 정지한다.
+ *  @param[in] 	this_gen AudioPlaylist 객체
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		재생중인 곡을 정지한다. \n
+ *  			다시 playAudioPlaylist() 를 호출하면 현재 곡의 처음부터 재생한다.
+ *  @see 		playAudioPlaylist
+ */
+bool stopAudioPlaylist (AudioPlaylist this_gen);
+
+/*! @fn 		bool nextAudioPlaylist (AudioPlaylist this_gen)
+ *  @brief 		다음 곡으로 넘어간다.
+ *  @param[in] 	this_gen AudioPlaylist 객체
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              마지막 곡이고 반복 재생이 아니면 @c false를 반환한다.
+ *  @note 		다음 곡으로 넘어간다. \n
+ *  			재생중이었으면 미리 준비된 다음 곡을 바로 재생한다.
+ *  @see 		getAudioPlaylistIndex
+ */
+bool nextAudioPlaylist (AudioPlaylist this_gen);
+
+/*! @fn 		int getAudioPlaylistIndex (AudioPlaylist this_gen)
+ *  @brief 		현재 곡의 index 를 가져온다.
+ *  @param[in] 	this_gen AudioPlaylist 객체
+ *  @param[out] null
+ *  @retval 	int \n
+ *              setAudioPlaylist() 로 설정한 목록에서의 index, 목록이 비어 있으면 -1
+ *  @note 		현재 곡의 index 를 가져온다. \n
+ *  			곡이 끝나 다음 곡으로 넘어가면 바로 갱신된다.
+ *  @see 		nextAudioPlaylist
+ */
+int getAudioPlaylistIndex (AudioPlaylist this_gen);
+
+/*! @fn 		bool setAudioPlaylistRepeat (AudioPlaylist this_gen, bool repeat)
+ *  @brief 		목록 전체의 반복 재생 여부를 설정한다.
+ *  @param[in] 	this_gen AudioPlaylist 객체
+ *  @param[in] 	repeat @c true 이면 마지막 곡 다음에 첫 곡을 재생한다.
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		목록 전체의 반복 재생 여부를 설정한다. \n
+ *  @see 		nextAudioPlaylist
+ */
+bool setAudioPlaylistRepeat (AudioPlaylist this_gen, bool repeat);
+/* AudioPlaylist */
+
+/* MediaInfo */
+/*! @struct	MediaInfo
+ *  @brief	getMediaInfoBatch() 로 읽은 동영상 / 음악 파일 하나의 meta data 이다.
+ *  @note	숫자 항목은 값이 없으면 -1, 문자열 항목은 값이 없으면 빈 문자열이다. \n
+ *          @a valid 가 @c false 이면 파일을 읽지 못한 것이며 나머지 항목은 모두 값이 없는 것으로 채워진다. \n
+ *          문자열은 배열 크기에 맞게 잘린다.
+ */
+typedef struct _MediaInfo
+{
+    bool valid;
+    bool hasVideo;
+    bool hasAudio;
+    int  duration;        // ms
+    int  width;
+    int  height;
+    int  rotate;          // 0 / 90 / 180 / 270
+    int  videoBitrate;
+    int  audioBitrate;
+    int  audioChannels;
+    int  audioSamplerate;
+    char title[128];
+    char artist[128];
+    char album[128];
+    char genre[64];
+    char date[32];
+
+} MediaInfo;
+
+/*! @fn 		bool getMediaInfoBatch (String * paths, int count, MediaInfo * infos, int threadCount)
+ *  @brief 		여러 동영상 / 음악 파일의 meta data 를 한번에 읽는다.
+ *  @param[in] 	paths 파일의 path 배열
+ *  @param[in] 	count @a paths 의 크기
+ *  @param[out] infos @a paths 와 같은 순서로 채워질 결과 배열 (크기 @a count)
+ *  @param[in] 	threadCount 사용할 thread 수 (0 이하이면 CPU core 수)
+ *  @retval 	bool \n
+ *              모든 파일을 읽었으면 @c true 를 반환한다. \n
+ *              읽지 못한 파일이 있으면 @c false를 반환하며 해당 항목의 @a valid 가 @c false 이다.
+ *  @note 		여러 동영상 / 음악 파일의 meta data 를 한번에 읽는다. \n
+ *  			thread 마다 metadata extractor 를 하나씩 만들어 파일들을 나누어 읽으므로 목록 화면처럼 많은 파일의 정보가 필요할 때 \n
+ *  			파일마다 Video / Audio 객체를 만들어 getVideoInfo() / getAudioInfo() 를 호출하는 것보다 빠르다.
+ *  @see 		getVideoInfo \n
+ *  			getAudioInfo
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ *  @warning    호출한 thread 도 작업에 참여하므로 모든 파일을 읽을 때까지 반환하지 않는다. main loop 에서는 적은 수만 사용해야 한다.
+ */
+bool getMediaInfoBatch (String * paths, int count, MediaInfo * infos, int threadCount);
+/* MediaInfo */
+
 
 /* Image */
+/*! @struct	ImageInfo
+ *  @brief	getImageInfoBatch() 로 조회한 사진 한장의 meta data 이다.
+ *  @note	DB 에 없는 파일이면 @a media_id 와 @a date_taken 은 빈 문자열, @a width 와 @a height 는 -1 이다. \n
+ *          @a date_taken 은 "YYYY:MM:DD HH:MM:SS" 형식이다.
+ */
+typedef struct _ImageInfo
+{
+    char media_id[40];
+    int  width;
+    int  height;
+    char date_taken[20];
+
+} ImageInfo;
+
+/*! @struct	ImageCacheInfo
+ *  @brief	ImageCache 에 저장되는 사진 한장의 meta data 와 thumbnail path 이다.
+ *  @note	@a thumbnail 은 media DB 가 만든 thumbnail 파일의 path 이며 아직 만들어지지 않았으면 빈 문자열이다.
+ */
+typedef struct _ImageCacheInfo
+{
+    ImageInfo info;
+    char      thumbnail[160];
+
+} ImageCacheInfo;
+
+typedef struct _ImageCache * ImageCache;
+
 /*! @struct	_Image
  *  @brief	Image 모듈에 대한 구조체이다. Image 모듈은 다양한 방식으로 동영상 파일을 제어 할 수 있다.
  *  @note	File의 Image 모듈에 대한 구조체이다. \n
@@ -730,6 +2749,8 @@ struct _Image
     int        (* getWidth) (Image this_gen);
 
     int        (* getHeight) (Image this_gen);
+
+    bool       (* setCache) (Image this_gen, ImageCache cache);
 };
 
 typedef struct _ImageExtends
@@ -743,6 +2764,8 @@ typedef struct _ImageExtends
     String datetaken;
     String media_id;
 
+    ImageCache cache;
+
 } ImageExtends;
 
 /*!	@fn			Image NewImage (void)
@@ -751,13 +2774,15 @@ typedef struct _ImageExtends
  *  @param[out] null
  *  @retval 	Video
  *  @note 		새로운 Image 객체를 생성한다. \n
- *  			Image 객체를 사용하기 전에 반드시 호출해야 한다.
+ *  			Image 객체를 사용하기 전에 반드시 호출해야 한다. \n
+ *  			media DB 연결은 Image / ImageCache 객체가 함께 사용하며 처음 조회할 때 연결되고 마지막 객체가 소멸될 때 끊어진다.
  *  @see 		DestroyImage \n
  *  			setImageURI \n
  *  			getImageMediaId \n
  *  			getImageDate \n
  *  			getImageWidth \n
- *  			getImageHeight
+ *  			getImageHeight \n
+ *  			setImageCache
  *  @warning    사용이 끝났을 때 DestoryImage() 함수를 꼭 사용해야 한다.
  *
  *  @code{.c}
@@ -771,10 +2796,12 @@ Image NewImage ()
     this->image.getDate		 = getImageDate;
     this->image.getWidth     = getImageWidth;
     this->image.getHeight    = getImageHeight;
+    this->image.setCache     = setImageCache;
     this->height             = -1;
     this->width              = -1;
     this->datetaken          = NULL;
     this->media_id           = NULL;
+    this->cache              = NULL;
 
     return &this->image;
 }
@@ -788,7 +2815,8 @@ Image NewImage (void);
  *  @param[out] null
  *  @retval 	void
  *  @note 		생성한 Image 객체를 소멸 시킨다. \n
- *  			Image 객체를 사용한 후 반드시 호출해야 한다.
+ *  			Image 객체를 사용한 후 반드시 호출해야 한다. \n
+ *  			media DB 연결을 사용하는 마지막 객체이면 연결을 끊는다.
  *  @see 		NewImage
  */
 void DestroyImage (Image this_gen);
@@ -802,6 +2830,8 @@ void DestroyImage (Image this_gen);
  *              함수의 성공 여부를 반환한다. \n
  *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
  *  @note 		생성한 Image 객체의 URI를 설정한다. \n
+ *  			setImageCache() 로 ImageCache 가 지정되어 있으면 cache 에서 먼저 찾는다. \n
+ *  			media DB 연결은 호출할 때마다 만들지 않고 객체들이 함께 사용한다.
  *  @see 		NewImage \n
  *  			DestroyImage \n
  *  			getImageMediaId \n
@@ -876,8 +2906,166 @@ int getImageWidth (Image this_gen);
  *  @warning   사용 전 setImageURI()를 최소 한번 이상 호출해야 한다.
  */
 int getImageHeight (Image this_gen);
+
+/*! @fn 		bool getImageInfoBatch (String * paths, int count, ImageInfo * infos)
+ *  @brief 		여러 사진 파일의 meta data 를 한번에 가져온다.
+ *  @param[in] 	paths 사진 파일의 path 배열
+ *  @param[in] 	count @a paths 의 크기
+ *  @param[out] infos @a paths 와 같은 순서로 채워질 결과 배열 (크기 @a count)
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		여러 사진 파일의 meta data 를 한번에 가져온다. \n
+ *  			media_content 에 한번 연결하여 @c MEDIA_PATH @c IN 조건의 query 로 조회하므로 파일마다 setImageURI() 를 호출하는 것보다 훨씬 빠르다. \n
+ *  			조건이 64 KB 를 넘으면 나누어 조회한다. \n
+ *  			살아 있는 Image / ImageCache 객체가 있으면 그 media DB 연결을 함께 사용한다. \n
+ *  			DB 에 없는 파일은 ImageInfo 의 설명과 같이 표시되며 실패로 처리하지 않는다.
+ *  @see 		setImageURI \n
+ *  			getImageMediaId \n
+ *  			getImageDate \n
+ *  			getImageWidth \n
+ *  			getImageHeight
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ */
+bool getImageInfoBatch (String * paths, int count, ImageInfo * infos);
+
+/*! @fn 		bool setImageCache (Image this_gen, ImageCache cache)
+ *  @brief 		setImageURI() 가 사용할 ImageCache 를 지정한다.
+ *  @param[in] 	this_gen Image 객체
+ *  @param[in] 	cache 사용할 ImageCache 객체 (@c NULL 이면 cache 를 사용하지 않는다.)
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		setImageURI() 가 사용할 ImageCache 를 지정한다. \n
+ *  			여러 Image 객체가 하나의 ImageCache 를 함께 사용할 수 있다.
+ *  @see 		setImageURI \n
+ *  			NewImageCache
+ *  @warning    @a cache 는 Image 객체보다 나중에 소멸시켜야 한다.
+ */
+bool setImageCache (Image this_gen, ImageCache cache);
 /* Image */
 
+/* ImageCache */
+/*! @struct	_ImageCache
+ *  @brief	ImageCache 모듈에 대한 구조체이다. ImageCache 모듈은 사진의 meta data 와 thumbnail path 를 path + mtime + size 로 cache 한다.
+ *  @note	File의 ImageCache 모듈에 대한 구조체이다. \n
+    		구조체를 사용하기 전에 NewImageCache() 함수를 사용해야 하며 사용이 끝났을 때 DestroyImageCache() 함수를 꼭 사용해야 한다. \n
+    		cache 는 mmap 으로 읽고 쓰는 파일에 저장되어 app 을 다시 실행해도 유지되며 그 앞의 LRU 가 최근 항목을 memory 에 유지한다. \n
+    		파일이 수정되어 mtime 이나 크기가 바뀌면 해당 항목은 무시되고 media DB 에서 다시 가져온다.
+ *  @see	NewImage \n
+ *  		getImageInfoBatch
+ *  @pre	@b privilege \n
+ *          * http://tizen.org/privilege/mediastorage \n
+ *  		* http://tizen.org/privilege/externalstorage
+ */
+struct _ImageCache
+{
+    bool (* Get) (ImageCache this_gen, String path, ImageCacheInfo * info);
+
+    bool (* Prefetch) (ImageCache this_gen, String * paths, int count);
+};
+
+typedef struct _ImageCacheExtends
+{
+    struct _ImageCache cache;
+    String             file;
+    char             * map;      // 저장소 파일의 mmap
+    size_t             mapSize;
+    int                capacity; // LRU 에 유지할 항목 수
+    GHashTable       * index;    // path -> lru 의 GList link
+    GQueue             lru;      // head 가 가장 최근에 사용한 항목
+    GQueue             pending;  // prefetch 할 path
+    GThread          * thread;
+    GMutex             lock;
+    GCond              cond;
+    bool               stop;
+
+} ImageCacheExtends;
+
+/*!	@fn			ImageCache NewImageCache (String file, int memoryEntries)
+ *  @brief		새로운 ImageCache 객체를 생성한다.
+ *  @param[in]	file cache 를 저장할 파일의 path (없으면 새로 만든다.)
+ *  @param[in]	memoryEntries memory 의 LRU 에 유지할 항목 수 (0 이하이면 256)
+ *  @param[out] null
+ *  @retval 	ImageCache \n
+ *              @a file 을 열거나 만들 수 없으면 @c NULL 을 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		새로운 ImageCache 객체를 생성한다. \n
+ *  			@a file 이 손상되었거나 형식이 다르면 비우고 새로 만든다.
+ *  @see 		DestroyImageCache \n
+ *  			getImageCacheInfo \n
+ *  			prefetchImageCache
+ *  @warning    사용이 끝났을 때 DestroyImageCache() 함수를 꼭 사용해야 한다. \n
+ *              같은 @a file 을 여러 ImageCache 객체나 process 가 동시에 사용하면 안된다.
+ *
+ *  @code{.c}
+ *  ImageCache NewImageCache (String file, int memoryEntries)
+ *  {
+ *      ImageCacheExtends * this = (ImageCacheExtends *)malloc (sizeof (ImageCacheExtends));
+ *
+ *      this->cache.Get      = getImageCacheInfo;
+ *      this->cache.Prefetch = prefetchImageCache;
+ *
+ *      ...
+ *
+ *      return &this->cache;
+ *  }
+ *  @endcode
+ */
+ImageCache NewImageCache (String file, int memoryEntries);
+
+/*! @fn 		void DestroyImageCache (ImageCache this_gen)
+ *  @brief 		생성한 ImageCache 객체를 소멸 시킨다.
+ *  @param[in] 	this_gen 소멸시킬 ImageCache 객체
+ *  @param[out] null
+ *  @retval 	void
+ *  @note 		생성한 ImageCache 객체를 소멸 시킨다. \n
+ *  			진행중인 prefetch 는 지금 처리중인 묶음까지만 마치고 나머지는 버린다.
+ *  @see 		NewImageCache
+ */
+void DestroyImageCache (ImageCache this_gen);
+
+/*! @fn 		bool getImageCacheInfo (ImageCache this_gen, String path, ImageCacheInfo * info)
+ *  @brief 		사진 파일의 meta data 와 thumbnail path 를 cache 에서 가져온다.
+ *  @param[in] 	this_gen ImageCache 객체
+ *  @param[in] 	path 사진 파일의 path
+ *  @param[out] info 사진의 meta data 와 thumbnail path
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              파일이 없거나 media DB 에 없으면 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		memory LRU, 저장소 파일 순으로 찾고 없으면 media DB 에서 가져와 cache 에 저장한다. \n
+ *  			cache 에 있으면 @c stat 한번 외에는 disk 나 DB 에 접근하지 않는다.
+ *  @see 		NewImageCache \n
+ *  			prefetchImageCache
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ */
+bool getImageCacheInfo (ImageCache this_gen, String path, ImageCacheInfo * info);
+
+/*! @fn 		bool prefetchImageCache (ImageCache this_gen, String * paths, int count)
+ *  @brief 		여러 사진 파일을 background 에서 미리 cache 에 올린다.
+ *  @param[in] 	this_gen ImageCache 객체
+ *  @param[in] 	paths 사진 파일의 path 배열
+ *  @param[in] 	count @a paths 의 크기
+ *  @param[out] null
+ *  @retval 	bool \n
+ *              함수의 성공 여부를 반환한다. \n
+ *              실패시 @c false를 반환하며 상세한 원인을 Log로 출력한다.
+ *  @note 		@a paths 를 복사하여 prefetch 목록에 넣고 바로 반환한다. \n
+ *  			background thread 가 목록을 64 개씩 묶어 cache 에 없는 항목만 getImageInfoBatch() 와 같은 방식으로 한번에 조회한다. \n
+ *  			gallery 에서 다음에 보일 화면의 path 를 넘겨주면 scroll 중의 getImageCacheInfo() 가 DB 를 기다리지 않는다.
+ *  @see 		NewImageCache \n
+ *  			getImageCacheInfo
+ *  @pre        @b privilege \n
+ *              * http://tizen.org/privilege/mediastorage \n
+ *              * http://tizen.org/privilege/externalstorage
+ */
+bool prefetchImageCache (ImageCache this_gen, String * paths, int count);
+/* ImageCache */
+
 #ifdef __cplusplus
 }
 #endif
@@ -4,17 +4,39 @@
  *  @see	File.h
 */
 
+// fallocate () 등 GNU 확장 함수를 사용한다.
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
 
 #include "Device/File.h"
 #include "dit.h"
 
 #include <stdlib.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/inotify.h>
+#include <poll.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
 #include <dirent.h>
+#include <limits.h>
+#include <fnmatch.h>
 #include <unistd.h>
 
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
 #include <glib.h>
 #include <tizen.h>
 #include <player.h>
@@ -25,19 +47,98 @@
 
 static void player_completed_callback (void * user_data);
 
-static void deletemediaresult (gpointer data);
-
 static void deleteSearchListElement (gpointer data);
 
+static bool copy_path (String src, String dst, unsigned int flags);
+
+static void sync_parent_dir (String path);
+
+static bool image_query (String * paths, int count, ImageInfo * infos, ImageCacheInfo * entries);
+
+#define COPY_BUFFER_SIZE  (1024 * 1024)
+#define COPY_BUFFER_ALIGN 4096
+#define COPY_CHUNK_SIZE   (64 * 1024 * 1024)
+#define COPY_JOB_CHUNK    (4 * 1024 * 1024) // 취소 / 진행 상황 확인 단위
+#define COPY_JOB_INTERVAL 200               // ms
+#define COPY_PARALLEL_CHUNK (8 * 1024 * 1024)
+
+#ifndef SEEK_DATA
+#define SEEK_DATA 3
+#define SEEK_HOLE 4
+#endif
+
+#ifndef FICLONE
+#define FICLONE _IOW (0x94, 9, int)
+#endif
+
+#define COPY_FLAG_PRESERVE   0x01 // mode / timestamp 유지
+#define COPY_FLAG_SYNC       0x02 // 복사 완료 후 fsync
+#define COPY_FLAG_CLONE      0x04 // FICLONE 을 먼저 시도
+#define COPY_FLAG_CLONE_ONLY 0x08 // clone 이 안되면 실패
+
+#define SEARCH_DIRENT_SIZE (64 * 1024)
+
+#define ATOMIC_BUFFER_SIZE (64 * 1024)
+#define ATOMIC_GROUP_MAX   64 // writeFilesAtomic 에서 한번에 열어두는 임시 파일 수
+
+#define DUPLICATE_PREFIX_SIZE 4096
+#define DUPLICATE_BUFFER_SIZE (256 * 1024)
+
+#define IMAGE_QUERY_CONDITION_MAX (64 * 1024) // 한번의 query 로 보내는 filter 조건의 최대 길이
+
+#define PLAYER_POOL_PLAYERS  2            // 기본 player 수
+#define PLAYER_POOL_COST     (8 * 1024 * 1024) // playerCost 가 0 이면 player 하나가 이만큼 쓰는 것으로 본다.
+
+#define IMAGE_CACHE_MAGIC          "DITIMGC"
+#define IMAGE_CACHE_VERSION        1
+#define IMAGE_CACHE_SLOTS          1024        // 처음 만들 때의 slot 수
+#define IMAGE_CACHE_MAX_SLOTS      (64 * 1024) // 이보다 커져야 하면 비우고 다시 시작한다.
+#define IMAGE_CACHE_MEMORY         256         // 기본 LRU entry 수
+#define IMAGE_CACHE_PREFETCH_BATCH 64
+
+#define USAGE_RACY_WINDOW 2 // s, 이 시간 안에 바뀐 directory 는 다음 update 때 다시 읽는다.
+
+#ifndef MADV_HUGEPAGE
+#define MADV_HUGEPAGE 14
+#endif
+
+#define FILE_INDEX_MAGIC      "DITINDEX"
+#define FILE_INDEX_VERSION    1
+#define FILE_INDEX_COMPACT    4096 // overlay 변경이 이 수를 넘으면 index 를 다시 만든다.
+#define FILE_INDEX_EVENT_SIZE (16 * 1024)
+#define FILE_INDEX_MASK       (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_MOVE_SELF | IN_ONLYDIR | IN_DONT_FOLLOW)
+
+#define FILE_WATCHER_MASK      (IN_CREATE | IN_DELETE | IN_MODIFY | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_DONT_FOLLOW)
+#define FILE_WATCHER_LIMIT     8192
+#define FILE_WATCHER_LATENCY   100  // ms
+#define FILE_WATCHER_BATCH_MAX 4096 // 한번에 전달할 최대 변경 경로 수
+
 File NewFile (void)
 {
     File this = malloc (sizeof (struct _File));
 
     this->Delete             = deleteFile;
     this->Copy               = copyFile;
+    this->CopyMode           = copyFileMode;
+    this->CopyChecksum       = copyFileChecksum;
+    this->CopyParallel       = copyFileParallel;
+    this->CopyTree           = copyTree;
+    this->MoveTree           = moveTree;
+    this->DeleteTree         = deleteTree;
+    this->Checksum           = checksumFile;
     this->Move               = moveFile;
     this->Search             = searchFile;
+    this->SearchParallel     = searchFileParallel;
+    this->SearchForeach      = searchFileForeach;
+    this->SearchMatch        = searchFileMatch;
+    this->SearchMatchForeach = searchFileMatchForeach;
     this->deleteSearchedList = deleteSearchedList;
+    this->Batch              = runFileBatch;
+    this->WriteAtomic        = writeFileAtomic;
+    this->WriteAtomicBatch   = writeFilesAtomic;
+    this->FindDuplicates     = findDuplicateFiles;
+    this->deleteDuplicates   = deleteDuplicateList;
+    this->Usage              = getDiskUsage;
     return this;
 }
 
@@ -87,38 +188,26 @@ bool moveFile (String src, String dst)
             return false;
         }
 
-        char buff[BUFSIZ];
-        FILE * in, * out;
-        size_t     n;
-        size_t     error;
-        in  = fopen (src, "rb");
-        out = fopen (dst, "wb");
-
-        if ( in == NULL)
+        // 같은 파일 시스템이면 metadata 변경만으로 이동이 끝난다.
+        // crash 후 원본 항목이 되살아나지 않도록 양쪽 directory 를 모두 fsync 한다.
+        if ( rename (src, dst) == 0 )
         {
-            dlog_print (DLOG_INFO, "DIT", "can not open source file : %s", src);
+            sync_parent_dir (dst);
+            sync_parent_dir (src);
+            return true;
         }
 
-        if ( out == NULL)
+        if ( errno != EXDEV )
         {
-            dlog_print (DLOG_INFO, "DIT", "can not open destination file : %s", dst);
+            dlog_print (DLOG_INFO, "DIT", "rename failed : %s", strerror (errno));
+            return false;
         }
 
-        while ((n = fread (buff, 1, BUFSIZ, in)) != 0)
+        if ( copy_path (src, dst, COPY_FLAG_PRESERVE | COPY_FLAG_SYNC) == false )
         {
-            error = fwrite (buff, 1, n, out);
-            if ( error == -1 )//error
-            {
-                fclose (in);
-                fclose (out);
-                remove (dst);
-                dlog_print (DLOG_INFO, "DIT", "FILE I/O ERROR");
-                return false;
-            }
+            return false;
         }
-
-        fclose (in);
-        fclose (out);
+        sync_parent_dir (dst);
 
         int ret = 0;
         ret = remove (src);
@@ -127,6 +216,7 @@ bool moveFile (String src, String dst)
             dlog_print (DLOG_INFO, "DIT", "FILE I/O ERROR");
             return false;
         }
+        sync_parent_dir (src);
         return true;
     }
     dlog_print (DLOG_INFO, "DIT", "src filename / dst filename not valid");
@@ -136,701 +226,7898 @@ bool moveFile (String src, String dst)
 
 bool copyFile (String src, String dst)
 {
-
-    if ( access (src, F_OK) == -1 )
+    if ( src != NULL && dst != NULL)
     {
-        dlog_print (DLOG_INFO, "DIT", "source file doesn't exist");
-        return false;
-    }
 
-    char buff[BUFSIZ];
-    FILE * in, * out;
-    size_t     n;
-    size_t     error;
-    in  = fopen (src, "rb");
-    out = fopen (dst, "wb");
-    if ( in == NULL)
-    {
-        dlog_print (DLOG_INFO, "DIT", "can not open source file : %s", src);
-    }
-    if ( out == NULL)
-    {
-        dlog_print (DLOG_INFO, "DIT", "can not open destination file : %s", dst);
+        if ( access (src, F_OK) == -1 )
+        {
+            dlog_print (DLOG_INFO, "DIT", "source file doesn't exist");
+            return false;
+        }
+
+        return copy_path (src, dst, COPY_FLAG_CLONE);
     }
+    dlog_print (DLOG_INFO, "DIT", "src filename / dst filename not valid");
+    return false;
+}
 
-    while ((n = fread (buff, 1, BUFSIZ, in)) != 0)
+bool copyFileMode (String src, String dst, copy_mode_e mode)
+{
+    if ( src != NULL && dst != NULL)
     {
-        error = fwrite (buff, 1, n, out);
-        if ( error == -1 )
+
+        if ( access (src, F_OK) == -1 )
         {
-            fclose (in);
-            fclose (out);
-            remove (dst);
-            dlog_print (DLOG_INFO, "DIT", "FILE I/O ERROR");
+            dlog_print (DLOG_INFO, "DIT", "source file doesn't exist");
+            return false;
+        }
+
+        switch (mode)
+        {
+        case COPY_MODE_CLONE_OR_COPY:
+            return copy_path (src, dst, COPY_FLAG_CLONE);
+
+        case COPY_MODE_CLONE:
+            return copy_path (src, dst, COPY_FLAG_CLONE | COPY_FLAG_CLONE_ONLY);
+
+        case COPY_MODE_COPY:
+            return copy_path (src, dst, 0);
+
+        default:
+            dlog_print (DLOG_INFO, "DIT", "copy mode not valid");
             return false;
         }
     }
-    fclose (in);
-    fclose (out);
-    return true;
+    dlog_print (DLOG_INFO, "DIT", "src filename / dst filename not valid");
+    return false;
 }
 
-// file search recursion Function using GList
-void search_recur (String src, String dest, GList ** searchList)
+// checksum : copy 중 buffer 를 지나가는 데이터로 CRC-32C / xxHash64 를 계산한다.
+#define XXH_PRIME64_1 0x9E3779B185EBCA87ULL
+#define XXH_PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define XXH_PRIME64_3 0x165667B19E3779F9ULL
+#define XXH_PRIME64_4 0x85EBCA77C2B2AE63ULL
+#define XXH_PRIME64_5 0x27D4EB2F165667C5ULL
+
+typedef struct _ChecksumState
 {
+    checksum_type_e type;
+    uint32_t        crc;
+    uint64_t        acc[4];
+    uint64_t        total;
+    unsigned char   buffer[32];
+    size_t          buffered;
 
-    DIR           * dp;
-    struct dirent * entry;
-    struct stat statbuf;
-    if ((dp = opendir (src)) == NULL)
-    {
-        dlog_print (DLOG_INFO, "DIT", "target source file doesn't exist");
-        return;
-    }
+} ChecksumState;
+
+static uint32_t crc32cTable[8][256];
 
-    chdir (src);
+static void crc32c_init_table (void)
+{
+    static gsize initialized = 0;
 
-    while ((entry = readdir (dp)) != NULL)
+    if ( g_once_init_enter (&initialized))
     {
-        lstat (entry->d_name, &statbuf);
-        if ( S_ISDIR(statbuf.st_mode))
+        for (uint32_t i = 0; i < 256; i++)
         {
-
-            /* Found a directory, but ignore . and .. */
-            if ( strcmp (".", entry->d_name) == 0 || strcmp ("..", entry->d_name) == 0 )
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++)
             {
-                continue;
+                crc = (crc >> 1) ^ (0x82F63B78 & (0 - (crc & 1)));
             }
+            crc32cTable[0][i] = crc;
+        }
 
-            if ( strcmp (entry->d_name, dest) == 0 )
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            for (int slice = 1; slice < 8; slice++)
             {
-                String pPath = realpath (entry->d_name, NULL);
-                *searchList = g_list_append (*searchList, (gpointer)pPath);
+                crc32cTable[slice][i] = (crc32cTable[slice - 1][i] >> 8) ^ crc32cTable[0][crc32cTable[slice - 1][i] & 0xFF];
             }
-
-            /* Recurse at a new indent level */
-            search_recur (entry->d_name, dest, searchList);
-
-        }
-        else if ( strcmp (entry->d_name, dest) == 0 )
-        {
-            String pPath = realpath (entry->d_name, NULL);
-            *searchList = g_list_append (*searchList, (gpointer)pPath);
-
         }
+        g_once_init_leave (&initialized, 1);
     }
-
-    chdir ("..");
-    closedir (dp);
 }
 
-GList * searchFile (String src, String dst)
+static uint64_t read_le64 (const unsigned char * p)
 {
-    GList * searchList = NULL;
-    search_recur (src, dst, &searchList);
+    uint64_t value;
 
-    return searchList;
+    memcpy (&value, p, sizeof (value));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64 (value);
+#endif
+    return value;
 }
 
-//callbacking function
-static void deleteSearchListElement (gpointer data)
+static uint32_t read_le32 (const unsigned char * p)
 {
-    free (data);
+    uint32_t value;
 
+    memcpy (&value, p, sizeof (value));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap32 (value);
+#endif
+    return value;
 }
 
-static void deletemediaresult (gpointer data)
+static uint32_t crc32c_update (uint32_t crc, const unsigned char * p, size_t len)
 {
-    free (data);
+#if defined(__SSE4_2__) && defined(__x86_64__)
+    uint64_t crc64 = crc;
+
+    for (; len >= 8; p += 8, len -= 8)
+    {
+        crc64 = _mm_crc32_u64 (crc64, read_le64 (p));
+    }
+    crc = (uint32_t)crc64;
+    for (; len > 0; p++, len--)
+    {
+        crc = _mm_crc32_u8 (crc, *p);
+    }
+#elif defined(__SSE4_2__)
+    for (; len >= 4; p += 4, len -= 4)
+    {
+        crc = _mm_crc32_u32 (crc, read_le32 (p));
+    }
+    for (; len > 0; p++, len--)
+    {
+        crc = _mm_crc32_u8 (crc, *p);
+    }
+#elif defined(__ARM_FEATURE_CRC32)
+    for (; len >= 8; p += 8, len -= 8)
+    {
+        crc = __crc32cd (crc, read_le64 (p));
+    }
+    for (; len > 0; p++, len--)
+    {
+        crc = __crc32cb (crc, *p);
+    }
+#else
+    // slicing-by-8 : 한번에 8 byte 씩 table 8 개로 처리한다.
+    for (; len >= 8; p += 8, len -= 8)
+    {
+        uint32_t low  = read_le32 (p) ^ crc;
+        uint32_t high = read_le32 (p + 4);
+
+        crc = crc32cTable[7][low & 0xFF] ^ crc32cTable[6][(low >> 8) & 0xFF]
+              ^ crc32cTable[5][(low >> 16) & 0xFF] ^ crc32cTable[4][low >> 24]
+              ^ crc32cTable[3][high & 0xFF] ^ crc32cTable[2][(high >> 8) & 0xFF]
+              ^ crc32cTable[1][(high >> 16) & 0xFF] ^ crc32cTable[0][high >> 24];
+    }
+    for (; len > 0; p++, len--)
+    {
+        crc = (crc >> 8) ^ crc32cTable[0][(crc ^ *p) & 0xFF];
+    }
+#endif
+    return crc;
 }
 
-void deleteSearchedList (GList * searchList)
+static uint64_t rotl64 (uint64_t value, int bits)
 {
+    return (value << bits) | (value >> (64 - bits));
+}
 
-    g_list_free_full (searchList, deleteSearchListElement);
-
+static uint64_t xxh64_round (uint64_t acc, uint64_t input)
+{
+    acc += input * XXH_PRIME64_2;
+    acc  = rotl64 (acc, 31);
+    return acc * XXH_PRIME64_1;
 }
 
-Video NewVideo (void)
+static uint64_t xxh64_merge (uint64_t hash, uint64_t acc)
 {
+    hash ^= xxh64_round (0, acc);
+    return hash * XXH_PRIME64_1 + XXH_PRIME64_4;
+}
 
-    VideoExtends * this = (VideoExtends *)malloc (sizeof (VideoExtends));
+static void xxh64_stripes (ChecksumState * state, const unsigned char * p, size_t stripes)
+{
+    uint64_t v1 = state->acc[0], v2 = state->acc[1], v3 = state->acc[2], v4 = state->acc[3];
 
-    this->video.getInfo   = getVideoInfo;
-    this->video.Pause     = pauseVideo;
-    this->video.Play      = playVideo;
-    this->video.Stop      = stopVideo;
-    this->video.setURI    = setVideoURI;
-    this->video.setObject = setEvasObject;
+    for (; stripes > 0; p += 32, stripes--)
+    {
+        v1 = xxh64_round (v1, read_le64 (p));
+        v2 = xxh64_round (v2, read_le64 (p + 8));
+        v3 = xxh64_round (v3, read_le64 (p + 16));
+        v4 = xxh64_round (v4, read_le64 (p + 24));
+    }
+    state->acc[0] = v1, state->acc[1] = v2, state->acc[2] = v3, state->acc[3] = v4;
+}
 
-    this->videoMetadataHandle = NULL;
-    this->player_handle       = NULL;
-    this->uri                 = NULL;
-    this->EvasObject          = NULL;
+static void checksum_init (ChecksumState * state, checksum_type_e type)
+{
+    memset (state, 0, sizeof (ChecksumState));
+    state->type = type;
+    state->crc  = 0xFFFFFFFF;
 
-    player_create (&this->player_handle);
-    metadata_extractor_create (&this->videoMetadataHandle);
+    state->acc[0] = XXH_PRIME64_1 + XXH_PRIME64_2;
+    state->acc[1] = XXH_PRIME64_2;
+    state->acc[2] = 0;
+    state->acc[3] = 0 - XXH_PRIME64_1;
 
-    return &this->video;
+    if ( type == CHECKSUM_CRC32C )
+    {
+        crc32c_init_table ();
+    }
 }
 
-void DestroyVideo (Video this_gen)
+static void checksum_update (ChecksumState * state, const void * data, size_t len)
 {
+    const unsigned char * p = (const unsigned char *)data;
 
-    if ( NULL != this_gen )
+    if ( state->type == CHECKSUM_CRC32C )
     {
+        state->crc = crc32c_update (state->crc, p, len);
+        return;
+    }
 
-        VideoExtends * this = (VideoExtends *)this_gen;
+    state->total += len;
 
-        metadata_extractor_destroy (this->videoMetadataHandle);
-        player_unprepare (this->player_handle);
-        player_destroy (this->player_handle);
+    if ( state->buffered + len < 32 )
+    {
+        memcpy (state->buffer + state->buffered, p, len);
+        state->buffered += len;
+        return;
+    }
 
-        if ( this->uri != NULL)
-        {
-            free (this->uri);
-        }
+    if ( state->buffered > 0 )
+    {
+        size_t fill = 32 - state->buffered;
 
-        free (this);
+        memcpy (state->buffer + state->buffered, p, fill);
+        xxh64_stripes (state, state->buffer, 1);
+        p   += fill;
+        len -= fill;
+        state->buffered = 0;
     }
+
+    xxh64_stripes (state, p, len / 32);
+    p   += len & ~(size_t)31;
+    len &= 31;
+
+    memcpy (state->buffer, p, len);
+    state->buffered = len;
 }
 
-bool playVideo (Video this_gen)
+static uint64_t checksum_final (ChecksumState * state)
 {
-    if ( this_gen != NULL)
+    if ( state->type == CHECKSUM_CRC32C )
     {
-        VideoExtends * this = (VideoExtends *)this_gen;
-
-        player_error_e ret = PLAYER_ERROR_NONE;
-
-        ret = player_prepare (this->player_handle);
-        if ( ret != PLAYER_ERROR_NONE && ret != PLAYER_ERROR_INVALID_STATE )
-        {
-            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (ret));
-            return false;
-        }
+        return state->crc ^ 0xFFFFFFFF;
+    }
 
-        player_unset_completed_cb (this->player_handle);
-        player_set_completed_cb (this->player_handle, player_completed_callback, this->player_handle);
+    uint64_t              hash;
+    const unsigned char * p   = state->buffer;
+    size_t                len = state->buffered;
 
-        ret = player_start (this->player_handle);
-        if ( ret != PLAYER_ERROR_NONE && ret != PLAYER_ERROR_INVALID_STATE )
+    if ( state->total >= 32 )
+    {
+        hash = rotl64 (state->acc[0], 1) + rotl64 (state->acc[1], 7) + rotl64 (state->acc[2], 12) + rotl64 (state->acc[3], 18);
+        for (int i = 0; i < 4; i++)
         {
-            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (ret));
-            return false;
+            hash = xxh64_merge (hash, state->acc[i]);
         }
-        return true;
     }
-    dlog_print (DLOG_INFO, "DIT", "NULL MODULE");
-    return false;
-}
+    else
+    {
+        hash = XXH_PRIME64_5;
+    }
+    hash += state->total;
 
-bool pauseVideo (Video this_gen)
-{
-    if ( this_gen != NULL)
+    for (; len >= 8; p += 8, len -= 8)
     {
-        VideoExtends * this = (VideoExtends *)this_gen;
-        player_error_e ret;
-        ret = player_pause (this->player_handle);
-        if ( ret != PLAYER_ERROR_NONE && ret != PLAYER_ERROR_INVALID_STATE )
-        {
-            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (ret));
-            return false;
-        }
-        return true;
+        hash ^= xxh64_round (0, read_le64 (p));
+        hash  = rotl64 (hash, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+    }
+    if ( len >= 4 )
+    {
+        hash ^= (uint64_t)read_le32 (p) * XXH_PRIME64_1;
+        hash  = rotl64 (hash, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+        p    += 4;
+        len  -= 4;
+    }
+    for (; len > 0; p++, len--)
+    {
+        hash ^= (*p) * XXH_PRIME64_5;
+        hash  = rotl64 (hash, 11) * XXH_PRIME64_1;
     }
 
-    dlog_print (DLOG_INFO, "DIT", "NULL module");
-    return false;
+    hash ^= hash >> 33;
+    hash *= XXH_PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= XXH_PRIME64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+// copy engine : copy_file_range -> sendfile -> aligned buffer loop
+static ssize_t copy_range_syscall (int in, loff_t * inOffset, int out, loff_t * outOffset, size_t len)
+{
+#ifdef __NR_copy_file_range
+    return syscall (__NR_copy_file_range, in, inOffset, out, outOffset, len, 0);
+#else
+    errno = ENOSYS;
+    return -1;
+#endif
+}
 
+static bool copy_fallback_errno (int err)
+{
+    return err == ENOSYS || err == EXDEV || err == EINVAL || err == EOPNOTSUPP || err == EBADF;
 }
 
-bool stopVideo (Video this_gen)
+static void copy_job_report (CopyJobExtends * job, gint64 now)
 {
-    if ( this_gen != NULL)
+    double elapsed = (now - job->lastTime) / 1000000.0;
+
+    // 최근 구간에 가중치를 두어 속도 변화를 따라가면서도 값이 튀지 않게 한다.
+    if ( elapsed > 0 )
     {
-        VideoExtends * this = (VideoExtends *)this_gen;
-        player_error_e ret;
-        ret = player_stop (this->player_handle);
-        if ( ret != PLAYER_ERROR_NONE && ret != PLAYER_ERROR_INVALID_STATE )
-        {
-            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (ret));
-            return false;
-        }
-        return true;
+        double rate = (job->progress.copied - job->lastCopied) / elapsed;
+
+        job->progress.bytesPerSecond = (job->progress.bytesPerSecond > 0) ? job->progress.bytesPerSecond * 0.7 + rate * 0.3 : rate;
     }
-    dlog_print (DLOG_INFO, "DIT", "NULL module");
-    return false;
+    job->progress.eta = (job->progress.bytesPerSecond > 0) ? (job->progress.total - job->progress.copied) / job->progress.bytesPerSecond : -1;
+
+    job->lastTime   = now;
+    job->lastCopied = job->progress.copied;
 }
 
-String getVideoInfo (Video this_gen, metadata_extractor_attr_e element)
+// 복사한 byte 를 반영하고 간격이 지났으면 callback 을 호출한다. 취소되었으면 false 를 반환한다.
+static bool copy_job_update (CopyJobExtends * job, off_t n)
 {
-    if ( this_gen != NULL)
+    gint64       now = g_get_monotonic_time ();
+    CopyProgress progress;
+    bool         report = false;
+
+    g_mutex_lock (&job->lock);
+    job->progress.copied += n;
+    if ( now - job->lastTime >= job->interval )
     {
-        VideoExtends * this = (VideoExtends *)this_gen;
-        String         resultInfo;
-        player_error_e ret  = PLAYER_ERROR_NONE;
-        ret = metadata_extractor_get_metadata (this->videoMetadataHandle, element, &resultInfo);
-        if ( ret != PLAYER_ERROR_NONE )
-        {
-            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (ret));
-            return NULL;
-        }
-        return resultInfo;
+        copy_job_report (job, now);
+        progress = job->progress;
+        report   = (job->callback != NULL);
     }
-    dlog_print (DLOG_INFO, "DIT", "NULL module");
-    return NULL;
+    g_mutex_unlock (&job->lock);
+
+    if ( report )
+    {
+        job->callback (&job->job, &progress, job->user_data);
+    }
+    return g_atomic_int_get (&job->cancel) == 0;
 }
 
-bool setVideoURI (Video this_gen, String uri)
+static bool copy_fd_buffer (int in, int out, off_t size, off_t * copied, CopyJobExtends * job, ChecksumState * checksum)
 {
-
-    if ( this_gen != NULL)
+    void * buff = NULL;
+    if ( posix_memalign (&buff, COPY_BUFFER_ALIGN, COPY_BUFFER_SIZE) != 0 )
     {
-        player_error_e ret = PLAYER_ERROR_NONE;
+        dlog_print (DLOG_INFO, "DIT", "copy buffer allocation failed");
+        return false;
+    }
 
-        if ( NULL == uri )
+    posix_fadvise (in, *copied, 0, POSIX_FADV_SEQUENTIAL);
+
+    ssize_t n;
+    while ((n = read (in, buff, COPY_BUFFER_SIZE)) != 0)
+    {
+        if ( n == -1 )
         {
-            dlog_print (DLOG_INFO, "DIT", "NULL URI");
+            if ( errno == EINTR )
+            {
+                continue;
+            }
+            free (buff);
             return false;
         }
 
-        VideoExtends * this = (VideoExtends *)this_gen;
-
-        if ( NULL != this->uri )
+        if ( checksum != NULL)
         {
-            free (this->uri);
+            checksum_update (checksum, buff, n);
         }
-        this->uri = malloc (strlen (uri) + sizeof (char));
-        strcpy (this->uri, uri);
 
-        ret = player_set_uri (this->player_handle, this->uri);
-        if ( ret != PLAYER_ERROR_NONE )
+        char * pos = (char *)buff;
+        while (n > 0)
         {
-            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (ret));
-            return false;
-        }
-        ret = metadata_extractor_set_path (this->videoMetadataHandle, this->uri);
-        if ( ret != PLAYER_ERROR_NONE )
+            ssize_t written = write (out, pos, n);
+            if ( written == -1 )
+            {
+                if ( errno == EINTR )
+                {
+                    continue;
+                }
+                free (buff);
+                return false;
+            }
+            pos += written;
+            n -= written;
+            *copied += written;
+        }
+
+        if ( job != NULL && copy_job_update (job, pos - (char *)buff) == false )
         {
-            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (ret));
+            free (buff);
+            errno = ECANCELED;
             return false;
         }
-        return true;
     }
-    dlog_print (DLOG_INFO, "DIT", "NULL module");
-    return false;
 
+    free (buff);
+    return true;
 }
 
-bool setEvasObject (Video this_gen, Evas_Object * EvasObject)
+static bool copy_fd (int in, int out, off_t size, CopyJobExtends * job)
 {
+    off_t   copied = 0;
+    off_t   chunk  = (job != NULL) ? COPY_JOB_CHUNK : COPY_CHUNK_SIZE;
+    ssize_t n;
 
-    if ( this_gen != NULL)
+    while (copied < size)
     {
-        VideoExtends * this = (VideoExtends *)this_gen;
+        n = copy_range_syscall (in, NULL, out, NULL, (size_t)MIN (size - copied, chunk));
+        if ( n == -1 && errno == EINTR )
+        {
+            continue;
+        }
+        if ( n <= 0 )
+        {
+            if ( n == -1 && copy_fallback_errno (errno) == false )
+            {
+                return false;
+            }
+            break;
+        }
+        copied += n;
+        if ( job != NULL && copy_job_update (job, n) == false )
+        {
+            errno = ECANCELED;
+            return false;
+        }
+    }
 
-        this->EvasObject = EvasObject;
+    while (copied < size)
+    {
+        n = sendfile (out, in, NULL, (size_t)MIN (size - copied, chunk));
+        if ( n == -1 && errno == EINTR )
+        {
+            continue;
+        }
+        if ( n <= 0 )
+        {
+            if ( n == -1 && copy_fallback_errno (errno) == false )
+            {
+                return false;
+            }
+            break;
+        }
+        copied += n;
+        if ( job != NULL && copy_job_update (job, n) == false )
+        {
+            errno = ECANCELED;
+            return false;
+        }
+    }
 
-        player_error_e ret = PLAYER_ERROR_NONE;
-        ret = player_set_display (this->player_handle, PLAYER_DISPLAY_TYPE_EVAS, GET_DISPLAY (this->EvasObject));
-        if ( ret != PLAYER_ERROR_NONE )
+    // 커널 복사가 불가능하거나 파일 크기가 변한 경우 남은 부분을 버퍼로 복사한다.
+    return copy_fd_buffer (in, out, size, &copied, job, NULL);
+}
+
+// offset 을 지정하여 하나의 data 구간을 복사한다. 파일 위치는 사용하지 않는다.
+static bool copy_extent (int in, int out, off_t offset, off_t len, CopyJobExtends * job, void ** buff)
+{
+    loff_t  inOffset  = offset;
+    loff_t  outOffset = offset;
+    off_t   chunk     = (job != NULL) ? COPY_JOB_CHUNK : COPY_CHUNK_SIZE;
+    bool    kernel    = true;
+    ssize_t n;
+
+    while (len > 0)
+    {
+        if ( kernel )
+        {
+            n = copy_range_syscall (in, &inOffset, out, &outOffset, (size_t)MIN (len, chunk));
+            if ( n == -1 && errno == EINTR )
+            {
+                continue;
+            }
+            if ( n == -1 && copy_fallback_errno (errno))
+            {
+                kernel = false;
+                continue;
+            }
+        }
+        else
+        {
+            if ( *buff == NULL && posix_memalign (buff, COPY_BUFFER_ALIGN, COPY_BUFFER_SIZE) != 0 )
+            {
+                *buff = NULL;
+                dlog_print (DLOG_INFO, "DIT", "copy buffer allocation failed");
+                return false;
+            }
+
+            n = pread (in, *buff, (size_t)MIN (len, COPY_BUFFER_SIZE), inOffset);
+            if ( n == -1 && errno == EINTR )
+            {
+                continue;
+            }
+            for (ssize_t done = 0, written; n > 0 && done < n; done += written)
+            {
+                written = pwrite (out, (char *)*buff + done, n - done, outOffset + done);
+                if ( written == -1 && errno == EINTR )
+                {
+                    written = 0;
+                }
+                else if ( written == -1 )
+                {
+                    return false;
+                }
+            }
+            if ( n > 0 )
+            {
+                inOffset  += n;
+                outOffset += n;
+            }
+        }
+
+        if ( n == -1 )
         {
-            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (ret));
             return false;
         }
-        ret = player_set_display_mode (this->player_handle, PLAYER_DISPLAY_MODE_ORIGIN_OR_LETTER);
-        if ( ret != PLAYER_ERROR_NONE )
+        // 복사 도중 원본이 줄어들면 미리 잡아둔 공간이 0 으로 남으므로 실패로 처리한다.
+        if ( n == 0 )
         {
-            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (ret));
+            errno = EIO;
             return false;
         }
 
-        return true;
+        len -= n;
+        if ( job != NULL && copy_job_update (job, n) == false )
+        {
+            errno = ECANCELED;
+            return false;
+        }
+    }
+    return true;
+}
+
+// hole 이 있는 파일은 data 구간만 fallocate 후 복사하고 나머지는 hole 로 남긴다.
+// SEEK_DATA 를 지원하지 않는 파일 시스템이면 -1 을 반환하며 이 경우 일반 복사를 사용한다.
+static int copy_fd_sparse (int in, int out, off_t size, CopyJobExtends * job)
+{
+    void * buff = NULL;
+    off_t  pos  = 0;
+    bool   ret  = true;
+
+    off_t data = lseek (in, 0, SEEK_DATA);
+    if ( data == -1 && errno != ENXIO )
+    {
+        return -1;
+    }
+
+    while (ret && data != -1 && data < size)
+    {
+        off_t hole = lseek (in, data, SEEK_HOLE);
+        if ( hole == -1 )
+        {
+            ret = false;
+            break;
+        }
+        hole = MIN (hole, size);
+
+        // 건너뛴 hole 도 진행 상황에 포함한다.
+        if ( job != NULL && data > pos && copy_job_update (job, data - pos) == false )
+        {
+            errno = ECANCELED;
+            ret   = false;
+            break;
+        }
+
+        // 미리 공간을 잡아 단편화를 줄인다. 지원하지 않아도 복사는 계속한다.
+        fallocate (out, 0, data, hole - data);
+
+        ret = copy_extent (in, out, data, hole - data, job, &buff);
+        pos = hole;
+
+        data = lseek (in, hole, SEEK_DATA);
+        if ( data == -1 && errno != ENXIO )
+        {
+            ret = false;
+        }
+    }
+
+    if ( ret && job != NULL && size > pos )
+    {
+        copy_job_update (job, size - pos);
+    }
+
+    // 마지막 hole 은 파일 크기로만 표현된다.
+    if ( ret && ftruncate (out, size) == -1 )
+    {
+        ret = false;
     }
-    dlog_print (DLOG_INFO, "DIT", "NULL module");
-    return false;
 
+    free (buff);
+    return ret ? 1 : 0;
 }
 
-Audio NewAudio ()
+// 열린 두 파일 사이에서 가장 빠른 방법으로 데이터를 복사하고 flags 에 따라 속성 유지 / fsync 한다.
+// src / dst 는 Log 에만 사용한다.
+static bool copy_fd_all (int in, int out, String src, String dst, struct stat * statbuf, unsigned int flags, CopyJobExtends * job, ChecksumState * checksum)
 {
+    if ( job != NULL)
+    {
+        g_mutex_lock (&job->lock);
+        job->progress.total = statbuf->st_size;
+        g_mutex_unlock (&job->lock);
+    }
 
-    AudioExtends * this = (AudioExtends *)malloc (sizeof (AudioExtends));
+    bool ret;
+    int  sparse = -1;
 
-    this->audio.getInfo = getAudioInfo;
-    this->audio.Pause   = pauseAudio;
-    this->audio.Play    = playAudio;
-    this->audio.Stop    = stopAudio;
-    this->audio.setURI  = setAudioURI;
+    // checksum 은 데이터가 buffer 를 지나가야 계산할 수 있다.
+    if ( checksum != NULL)
+    {
+        off_t copied = 0;
 
-    this->uri                 = NULL;
-    this->player_handle       = NULL;
-    this->audioMetadataHandle = NULL;
+        ret = copy_fd_buffer (in, out, statbuf->st_size, &copied, job, checksum);
+    }
+    // copy-on-write 파일 시스템이면 데이터를 복사하지 않고 block 을 공유한다.
+    else if ((flags & COPY_FLAG_CLONE) && ioctl (out, FICLONE, in) == 0 )
+    {
+        ret = (job == NULL) || copy_job_update (job, statbuf->st_size);
+    }
+    else if ( flags & COPY_FLAG_CLONE_ONLY )
+    {
+        dlog_print (DLOG_INFO, "DIT", "can not clone %s : %s", src, strerror (errno));
+        ret = false;
+    }
+    else
+    {
+        // 할당된 block 이 파일 크기보다 작으면 hole 이 있는 파일이다.
+        if ( S_ISREG (statbuf->st_mode) && (off_t)statbuf->st_blocks * 512 < statbuf->st_size )
+        {
+            sparse = copy_fd_sparse (in, out, statbuf->st_size, job);
+        }
 
-    player_create (&this->player_handle);
-    metadata_extractor_create (&this->audioMetadataHandle);
+        ret = (sparse == -1) ? copy_fd (in, out, statbuf->st_size, job) : sparse == 1;
+    }
 
-    return &this->audio;
+    if ( ret == true && (flags & COPY_FLAG_PRESERVE))
+    {
+        struct timespec times[2] = {statbuf->st_atim, statbuf->st_mtim};
+
+        if ( fchmod (out, statbuf->st_mode & 07777) == -1 || futimens (out, times) == -1 )
+        {
+            dlog_print (DLOG_INFO, "DIT", "can not preserve attributes : %s : %s", dst, strerror (errno));
+        }
+    }
+
+    if ( ret == true && (flags & COPY_FLAG_SYNC) && fsync (out) == -1 )
+    {
+        ret = false;
+    }
+
+    return ret;
 }
 
-void DestroyAudio (Audio this_gen)
+static bool copy_path_job (String src, String dst, unsigned int flags, CopyJobExtends * job, ChecksumState * checksum);
+
+static bool copy_path (String src, String dst, unsigned int flags)
 {
+    return copy_path_job (src, dst, flags, NULL, NULL);
+}
 
-    if ( this_gen != NULL)
+static volatile gint temp_sequence = 0;
+
+// path 와 같은 directory 에 겹치지 않는 이름으로 임시 파일을 만들고 그 이름을 temp 에 기록한다.
+// temp 는 strlen (path) + 32 byte 이상이어야 한다.
+static int open_temp_file (String path, String temp, mode_t mode)
+{
+    // rename 이 원자적이려면 같은 파일 시스템이어야 하므로 같은 directory 에 만든다.
+    String slash  = strrchr (path, '/');
+    int    dirlen = (slash == NULL) ? 0 : (int)(slash - path + 1);
+    int    fd;
+
+    do
     {
-        AudioExtends * this = (AudioExtends *)this_gen;
+        sprintf (temp, "%.*s.%s.%d.%d.tmp", dirlen, path, path + dirlen, getpid (), g_atomic_int_add (&temp_sequence, 1));
+        fd = open (temp, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, mode);
+    } while (fd == -1 && errno == EEXIST);
 
-        if ( this->uri != NULL)
+    return fd;
+}
+
+static bool copy_path_job (String src, String dst, unsigned int flags, CopyJobExtends * job, ChecksumState * checksum)
+{
+    struct stat statbuf;
+    int         in, out;
+    String      temp    = NULL;
+    bool        created = false;
+    int         error;
+
+    // 실패할 때 errno 가 설정되지 않는 경우 (원본이 줄어든 경우 등) 를 구분하기 위해 지운다.
+    errno = 0;
+
+    in = open (src, O_RDONLY);
+    if ( in == -1 )
+    {
+        error = errno;
+        dlog_print (DLOG_INFO, "DIT", "can not open source file : %s", src);
+        errno = error;
+        return false;
+    }
+
+    if ( fstat (in, &statbuf) == -1 )
+    {
+        error = errno;
+        close (in);
+        dlog_print (DLOG_INFO, "DIT", "FILE I/O ERROR : %s", src);
+        errno = error;
+        return false;
+    }
+
+    if ( flags & COPY_FLAG_CLONE_ONLY )
+    {
+        // clone 이 안되어 실패하더라도 기존 dst 가 남도록 임시 파일에 만든 후 rename 한다.
+        struct stat dststat;
+
+        temp = (String)malloc (strlen (dst) + 32);
+        out  = (temp == NULL) ? -1 : open_temp_file (dst, temp, statbuf.st_mode & 0777);
+
+        // 기존 파일이 있으면 권한을 유지한다.
+        if ( out != -1 && stat (dst, &dststat) == 0 )
         {
-            free (this->uri);
+            fchmod (out, dststat.st_mode & 07777);
+        }
+    }
+    else
+    {
+        // 새로 만든 파일만 실패시 지운다.
+        out     = open (dst, O_WRONLY | O_CREAT | O_EXCL, statbuf.st_mode & 0777);
+        created = (out != -1);
+        if ( out == -1 && errno == EEXIST )
+        {
+            out = open (dst, O_WRONLY);
         }
+    }
 
-        metadata_extractor_destroy (this->audioMetadataHandle);
-        player_unprepare (this->player_handle);
-        player_destroy (this->player_handle);
-        free (this);
+    if ( out == -1 )
+    {
+        error = (errno != 0) ? errno : EIO;
+        close (in);
+        dlog_print (DLOG_INFO, "DIT", "can not open destination file : %s", dst);
+        free (temp);
+        errno = error;
+        return false;
     }
 
-    dlog_print (DLOG_INFO, "DIT", "NULL module");
-    return;
+    struct stat outstat;
+
+    // 같은 파일에 덮어쓰면 원본이 지워진다.
+    if ( temp == NULL && created == false && fstat (out, &outstat) == 0 && outstat.st_dev == statbuf.st_dev && outstat.st_ino == statbuf.st_ino )
+    {
+        close (in);
+        close (out);
+        dlog_print (DLOG_INFO, "DIT", "src and dst are the same file : %s", dst);
+        errno = EINVAL;
+        return false;
+    }
+
+    // 기존 dst 는 inode 를 유지하도록 그 자리에서 비우고 clone / 복사한다.
+    bool ret = (temp != NULL || created || ftruncate (out, 0) == 0) && copy_fd_all (in, out, src, dst, &statbuf, flags, job, checksum);
+
+    // rename 전에 기록해야 crash 후 빈 파일로 교체되지 않는다.
+    if ( ret == true && temp != NULL && (flags & COPY_FLAG_SYNC) == 0 && fsync (out) == -1 )
+    {
+        ret = false;
+    }
+
+    close (in);
+    if ( close (out) == -1 )
+    {
+        ret = false;
+    }
+
+    if ( ret == true && temp != NULL && rename (temp, dst) == -1 )
+    {
+        ret = false;
+    }
+
+    if ( ret == false )
+    {
+        // 호출한 쪽에서 원인을 알 수 있도록 errno 를 유지하며, 원인을 모르면 EIO 로 한다.
+        error = (errno != 0) ? errno : EIO;
 
+        if ( temp != NULL)
+        {
+            unlink (temp);
+        }
+        else if ( created )
+        {
+            remove (dst);
+        }
+        dlog_print (DLOG_INFO, "DIT", "FILE I/O ERROR : %s -> %s", src, dst);
+        errno = error;
+    }
+    free (temp);
+    return ret;
 }
 
-bool playAudio (Audio this_gen)
+static String parent_dir (String path)
 {
-    if ( this_gen != NULL)
+    String dir = strdup (path);
+    if ( dir == NULL)
     {
-        player_error_e res;
+        return NULL;
+    }
 
-        AudioExtends * this = (AudioExtends *)this_gen;
+    String slash = strrchr (dir, '/');
+    if ( slash == NULL)
+    {
+        strcpy (dir, ".");
+    }
+    else if ( slash == dir )
+    {
+        dir[1] = '\0';
+    }
+    else
+    {
+        *slash = '\0';
+    }
+    return dir;
+}
 
-        res = player_prepare (this->player_handle);
+static void sync_dir (String dir)
+{
+    int fd = open (dir, O_RDONLY | O_DIRECTORY);
+    if ( fd != -1 )
+    {
+        fsync (fd);
+        close (fd);
+    }
+}
 
-        if ( res != PLAYER_ERROR_NONE && res != PLAYER_ERROR_INVALID_STATE )
+// rename / unlink 결과가 crash 이후에도 남도록 상위 디렉토리를 fsync 한다.
+static void sync_parent_dir (String path)
+{
+    String dir = parent_dir (path);
+    if ( dir != NULL)
+    {
+        sync_dir (dir);
+        free (dir);
+    }
+}
+
+bool copyFileChecksum (String src, String dst, checksum_type_e type, uint64_t * checksum)
+{
+    if ( src != NULL && dst != NULL && checksum != NULL)
+    {
+
+        if ( access (src, F_OK) == -1 )
         {
-            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (res));
+            dlog_print (DLOG_INFO, "DIT", "source file doesn't exist");
+            return false;
         }
-        player_unset_completed_cb (this->player_handle);
-        player_set_completed_cb (this->player_handle, player_completed_callback, this->player_handle);
-        res = player_start (this->player_handle);
 
-        if ( res != PLAYER_ERROR_NONE && res != PLAYER_ERROR_INVALID_STATE )
+        ChecksumState state;
+        checksum_init (&state, type);
+
+        if ( copy_path_job (src, dst, 0, NULL, &state) == false )
         {
-            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (res));
             return false;
         }
+
+        *checksum = checksum_final (&state);
         return true;
     }
-
-    dlog_print (DLOG_INFO, "DIT", "NULL module");
+    dlog_print (DLOG_INFO, "DIT", "src filename / dst filename / checksum not valid");
     return false;
 }
 
-bool pauseAudio (Audio this_gen)
+bool checksumFile (String src, checksum_type_e type, uint64_t * checksum)
 {
-    if ( this_gen != NULL)
+    if ( src != NULL && checksum != NULL)
     {
-        player_error_e res;
+        ChecksumState state;
+        void        * buff = NULL;
+        ssize_t       n;
 
-        AudioExtends * this = (AudioExtends *)this_gen;
+        int in = open (src, O_RDONLY | O_CLOEXEC);
+        if ( in == -1 )
+        {
+            dlog_print (DLOG_INFO, "DIT", "can not open source file : %s", src);
+            return false;
+        }
 
-        res = player_pause (this->player_handle);
+        if ( posix_memalign (&buff, COPY_BUFFER_ALIGN, COPY_BUFFER_SIZE) != 0 )
+        {
+            close (in);
+            dlog_print (DLOG_INFO, "DIT", "checksum buffer allocation failed");
+            return false;
+        }
 
-        if ( res != PLAYER_ERROR_NONE && res != PLAYER_ERROR_INVALID_STATE )
+        checksum_init (&state, type);
+        posix_fadvise (in, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+        while ((n = read (in, buff, COPY_BUFFER_SIZE)) != 0)
+        {
+            if ( n == -1 && errno == EINTR )
+            {
+                continue;
+            }
+            if ( n == -1 )
+            {
+                break;
+            }
+            checksum_update (&state, buff, n);
+        }
+
+        free (buff);
+        close (in);
+
+        if ( n == -1 )
+        {
+            dlog_print (DLOG_INFO, "DIT", "FILE I/O ERROR");
+            return false;
+        }
+
+        *checksum = checksum_final (&state);
+        return true;
+    }
+    dlog_print (DLOG_INFO, "DIT", "src filename / checksum not valid");
+    return false;
+}
+
+// parallel copy : 정렬된 조각들을 worker 들이 atomic index 로 나누어 가져간다.
+typedef struct _ParallelCopyContext
+{
+    int           in;
+    int           out;
+    off_t         size;
+    off_t         chunk;
+    gint          chunks;
+    volatile gint next;
+    volatile gint failed;
+    volatile gint error;
+
+} ParallelCopyContext;
+
+static gpointer copy_parallel_run (gpointer data)
+{
+    ParallelCopyContext * context = (ParallelCopyContext *)data;
+    void                * buff    = NULL;
+    int                   index;
+
+    while (g_atomic_int_get (&context->failed) == 0 && (index = g_atomic_int_add (&context->next, 1)) < context->chunks)
+    {
+        off_t offset = (off_t)index * context->chunk;
+        off_t len    = MIN (context->chunk, context->size - offset);
+
+        if ( copy_extent (context->in, context->out, offset, len, NULL, &buff) == false )
+        {
+            g_atomic_int_set (&context->error, errno);
+            g_atomic_int_set (&context->failed, 1);
+        }
+    }
+
+    free (buff);
+    return NULL;
+}
+
+bool copyFileParallel (String src, String dst, int threadCount, long long chunkSize)
+{
+    if ( src == NULL || dst == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "src filename / dst filename not valid");
+        return false;
+    }
+
+    ParallelCopyContext context;
+    struct stat         statbuf;
+    struct stat         dststat;
+
+    memset (&context, 0, sizeof (ParallelCopyContext));
+    context.chunk = (chunkSize > 0) ? (off_t)((chunkSize + COPY_BUFFER_ALIGN - 1) & ~(long long)(COPY_BUFFER_ALIGN - 1)) : COPY_PARALLEL_CHUNK;
+
+    if ( stat (src, &statbuf) == -1 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "source file doesn't exist");
+        return false;
+    }
+
+    bool exists = (stat (dst, &dststat) == 0);
+
+    if ( exists && dststat.st_dev == statbuf.st_dev && dststat.st_ino == statbuf.st_ino )
+    {
+        dlog_print (DLOG_INFO, "DIT", "src and dst are the same file : %s", dst);
+        errno = EINVAL;
+        return false;
+    }
+
+    // 작은 파일이나 hole 이 있는 파일은 나누어도 이득이 없거나 hole 을 잃는다.
+    if ( S_ISREG (statbuf.st_mode) == false || statbuf.st_size <= context.chunk * 2 || (off_t)statbuf.st_blocks * 512 < statbuf.st_size )
+    {
+        return copy_path (src, dst, COPY_FLAG_CLONE | COPY_FLAG_SYNC);
+    }
+
+    context.size   = statbuf.st_size;
+    context.chunks = (gint)((context.size + context.chunk - 1) / context.chunk);
+
+    context.in = open (src, O_RDONLY | O_CLOEXEC);
+    if ( context.in == -1 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "can not open source file : %s", src);
+        return false;
+    }
+
+    // 실패해도 기존 dst 가 남도록 임시 파일에 복사한 후 rename 한다.
+    String temp = (String)malloc (strlen (dst) + 32);
+
+    context.out = (temp == NULL) ? -1 : open_temp_file (dst, temp, statbuf.st_mode & 0777);
+    if ( context.out == -1 )
+    {
+        close (context.in);
+        dlog_print (DLOG_INFO, "DIT", "can not open destination file : %s", dst);
+        free (temp);
+        return false;
+    }
+
+    // 기존 파일이 있으면 권한을 유지한다.
+    if ( exists )
+    {
+        fchmod (context.out, dststat.st_mode & 07777);
+    }
+
+    // 크기를 먼저 잡아두면 worker 들의 pwrite 가 파일 끝을 늘리며 경쟁하지 않는다.
+    if ( fallocate (context.out, 0, 0, context.size) == -1 )
+    {
+        ftruncate (context.out, context.size);
+    }
+    posix_fadvise (context.in, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    if ( threadCount <= 0 )
+    {
+        threadCount = g_get_num_processors ();
+    }
+    threadCount = MIN (threadCount, context.chunks);
+
+    GThread ** threads = (GThread **)calloc (threadCount, sizeof (GThread *));
+
+    for (int i = 1; i < threadCount; i++)
+    {
+        threads[i] = g_thread_try_new ("FileCopy", copy_parallel_run, &context, NULL);
+    }
+    copy_parallel_run (&context);
+
+    for (int i = 1; i < threadCount; i++)
+    {
+        if ( threads[i] != NULL)
+        {
+            g_thread_join (threads[i]);
+        }
+    }
+    free (threads);
+
+    bool ret = (context.failed == 0) && fsync (context.out) == 0;
+
+    close (context.in);
+    if ( close (context.out) == -1 )
+    {
+        ret = false;
+    }
+
+    if ( ret == true && rename (temp, dst) == -1 )
+    {
+        ret = false;
+    }
+
+    if ( ret == false )
+    {
+        int error = context.error ? context.error : errno;
+
+        unlink (temp);
+        dlog_print (DLOG_INFO, "DIT", "FILE I/O ERROR : %s -> %s : %s", src, dst, strerror (error));
+        errno = error;
+    }
+    else
+    {
+        sync_parent_dir (dst);
+    }
+    free (temp);
+    return ret;
+}
+
+// batch : 작업들을 worker thread 들이 나누어 수행하고 directory fsync 는 마지막에 한번씩 모아서 한다.
+typedef struct _BatchContext
+{
+    FileOperation * operations;
+    int             count;
+    unsigned int    flags;
+    volatile gint   next;
+
+} BatchContext;
+
+static int batch_operation (FileOperation * operation, unsigned int flags)
+{
+    if ( operation->src == NULL || (operation->type != FILE_OPERATION_DELETE && operation->dst == NULL))
+    {
+        return EINVAL;
+    }
+
+    // copy_path 는 실패하면 0 이 아닌 errno 를 남긴다.
+    switch (operation->type)
+    {
+    case FILE_OPERATION_DELETE:
+        return (remove (operation->src) == 0) ? 0 : errno;
+
+    case FILE_OPERATION_COPY:
+        return copy_path (operation->src, operation->dst, flags | COPY_FLAG_CLONE) ? 0 : errno;
+
+    case FILE_OPERATION_MOVE:
+        if ( rename (operation->src, operation->dst) == 0 )
+        {
+            return 0;
+        }
+        if ( errno != EXDEV )
+        {
+            return errno;
+        }
+        if ( copy_path (operation->src, operation->dst, flags | COPY_FLAG_PRESERVE) == false )
+        {
+            return errno;
+        }
+        return (remove (operation->src) == 0) ? 0 : errno;
+
+    default:
+        return EINVAL;
+    }
+}
+
+static gpointer batch_worker_run (gpointer data)
+{
+    BatchContext * context = (BatchContext *)data;
+    int            index;
+
+    while ((index = g_atomic_int_add (&context->next, 1)) < context->count)
+    {
+        FileOperation * operation = &context->operations[index];
+
+        operation->result = batch_operation (operation, context->flags);
+        if ( operation->result != 0 )
+        {
+            dlog_print (DLOG_INFO, "DIT", "batch operation %d failed : %s", index, strerror (operation->result));
+        }
+    }
+    return NULL;
+}
+
+static void batch_add_dir (GHashTable * dirs, String path)
+{
+    String dir = parent_dir (path);
+
+    if ( dir != NULL && g_hash_table_contains (dirs, dir))
+    {
+        free (dir);
+    }
+    else if ( dir != NULL)
+    {
+        g_hash_table_add (dirs, dir);
+    }
+}
+
+bool runFileBatch (FileOperation * operations, int count, int threadCount, bool sync)
+{
+    BatchContext context;
+
+    if ( operations == NULL || count < 0 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "operations not valid");
+        return false;
+    }
+
+    if ( threadCount <= 0 )
+    {
+        threadCount = g_get_num_processors ();
+    }
+    if ( threadCount > count )
+    {
+        threadCount = count;
+    }
+
+    context.operations = operations;
+    context.count      = count;
+    context.flags      = sync ? COPY_FLAG_SYNC : 0;
+    context.next       = 0;
+
+    GThread ** threads = (GThread **)calloc (threadCount, sizeof (GThread *));
+
+    for (int i = 1; i < threadCount; i++)
+    {
+        threads[i] = g_thread_try_new ("FileBatch", batch_worker_run, &context, NULL);
+    }
+    batch_worker_run (&context);
+
+    for (int i = 1; i < threadCount; i++)
+    {
+        if ( threads[i] != NULL)
+        {
+            g_thread_join (threads[i]);
+        }
+    }
+    free (threads);
+
+    bool         ret  = true;
+    GHashTable * dirs = sync ? g_hash_table_new_full (g_str_hash, g_str_equal, free, NULL) : NULL;
+
+    for (int i = 0; i < count; i++)
+    {
+        if ( operations[i].result != 0 )
+        {
+            ret = false;
+        }
+        else if ( dirs != NULL)
+        {
+            batch_add_dir (dirs, operations[i].type == FILE_OPERATION_DELETE ? operations[i].src : operations[i].dst);
+            if ( operations[i].type == FILE_OPERATION_MOVE )
+            {
+                batch_add_dir (dirs, operations[i].src);
+            }
+        }
+    }
+
+    if ( dirs != NULL)
+    {
+        GHashTableIter iter;
+        gpointer       key;
+
+        g_hash_table_iter_init (&iter, dirs);
+        while (g_hash_table_iter_next (&iter, &key, NULL))
+        {
+            sync_dir ((String)key);
+        }
+        g_hash_table_destroy (dirs);
+    }
+
+    return ret;
+}
+
+// atomic : 같은 directory 의 임시 파일에 기록하고 fsync -> rename -> directory fsync 순서로 교체한다.
+static bool atomic_fail (AtomicFileExtends * this, int error)
+{
+    if ( this->error == 0 )
+    {
+        this->error = error;
+        dlog_print (DLOG_INFO, "DIT", "atomic write failed : %s : %s", this->path, strerror (error));
+    }
+    errno = error;
+    return false;
+}
+
+static bool atomic_write_fd (int fd, const char * data, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t n = write (fd, data, size);
+        if ( n == -1 )
+        {
+            if ( errno == EINTR )
+            {
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+static bool atomic_flush (AtomicFileExtends * this)
+{
+    if ( this->used > 0 )
+    {
+        if ( atomic_write_fd (this->fd, this->buffer, this->used) == false )
+        {
+            return atomic_fail (this, errno);
+        }
+        this->used = 0;
+    }
+    return true;
+}
+
+AtomicFile NewAtomicFile (String path)
+{
+    struct stat statbuf;
+
+    if ( path == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "path not valid");
+        return NULL;
+    }
+
+    AtomicFileExtends * this = (AtomicFileExtends *)malloc (sizeof (AtomicFileExtends));
+
+    this->file.Write  = writeAtomicFile;
+    this->file.Commit = commitAtomicFile;
+
+    this->path   = strdup (path);
+    this->temp   = (String)malloc (strlen (path) + 32);
+    this->buffer = NULL;
+    this->used   = 0;
+    this->error  = 0;
+    this->done   = false;
+
+    errno    = ENOMEM;
+    this->fd = (this->temp == NULL) ? -1 : open_temp_file (path, this->temp, 0666);
+
+    if ( this->fd == -1 )
+    {
+        int error = errno;
+
+        dlog_print (DLOG_INFO, "DIT", "can not create temporary file : %s : %s", path, strerror (error));
+        free (this->temp);
+        free (this->path);
+        free (this);
+        errno = error;
+        return NULL;
+    }
+
+    // 기존 파일이 있으면 권한을 유지한다.
+    if ( stat (path, &statbuf) == 0 )
+    {
+        fchmod (this->fd, statbuf.st_mode & 07777);
+    }
+
+    return &this->file;
+}
+
+void DestroyAtomicFile (AtomicFile this_gen)
+{
+    if ( this_gen != NULL)
+    {
+        AtomicFileExtends * this = (AtomicFileExtends *)this_gen;
+
+        if ( this->fd != -1 )
+        {
+            close (this->fd);
+        }
+        if ( this->done == false )
+        {
+            unlink (this->temp);
+        }
+
+        free (this->buffer);
+        free (this->temp);
+        free (this->path);
+        free (this);
+    }
+}
+
+bool writeAtomicFile (AtomicFile this_gen, const void * data, size_t size)
+{
+    if ( this_gen == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "AtomicFile not valid");
+        return false;
+    }
+
+    AtomicFileExtends * this = (AtomicFileExtends *)this_gen;
+
+    if ( this->done || this->error != 0 )
+    {
+        errno = this->done ? EINVAL : this->error;
+        return false;
+    }
+
+    // 기록이 빠진 채로 commit 되어 원래 파일이 잘리지 않도록 실패 상태로 만든다.
+    if ( data == NULL && size > 0 )
+    {
+        return atomic_fail (this, EINVAL);
+    }
+
+    // 큰 기록은 buffer 를 거치지 않는다.
+    if ( size >= ATOMIC_BUFFER_SIZE )
+    {
+        if ( atomic_flush (this) == false )
+        {
+            return false;
+        }
+        return atomic_write_fd (this->fd, data, size) ? true : atomic_fail (this, errno);
+    }
+
+    if ( this->buffer == NULL)
+    {
+        this->buffer = (char *)malloc (ATOMIC_BUFFER_SIZE);
+
+        // buffer 를 만들 수 없으면 바로 기록한다.
+        if ( this->buffer == NULL)
+        {
+            return atomic_write_fd (this->fd, data, size) ? true : atomic_fail (this, errno);
+        }
+    }
+    if ( this->used + size > ATOMIC_BUFFER_SIZE && atomic_flush (this) == false )
+    {
+        return false;
+    }
+
+    memcpy (this->buffer + this->used, data, size);
+    this->used += size;
+    return true;
+}
+
+// commit 전반부 : 남은 buffer 를 기록하고 writeback 을 시작한다.
+static bool atomic_begin (AtomicFileExtends * this)
+{
+    if ( this->done || this->error != 0 )
+    {
+        errno = this->done ? EINVAL : this->error;
+        return false;
+    }
+    if ( atomic_flush (this) == false )
+    {
+        return false;
+    }
+    sync_file_range (this->fd, 0, 0, SYNC_FILE_RANGE_WRITE);
+    return true;
+}
+
+// commit 후반부 : writeback 을 기다리고 원래 파일을 교체한다. directory fsync 는 호출한 쪽에서 한다.
+static bool atomic_finish (AtomicFileExtends * this)
+{
+    if ( fdatasync (this->fd) == -1 )
+    {
+        return atomic_fail (this, errno);
+    }
+
+    int ret = close (this->fd);
+    this->fd = -1;
+    if ( ret == -1 )
+    {
+        return atomic_fail (this, errno);
+    }
+
+    if ( rename (this->temp, this->path) == -1 )
+    {
+        return atomic_fail (this, errno);
+    }
+    this->done = true;
+    return true;
+}
+
+bool commitAtomicFile (AtomicFile this_gen)
+{
+    if ( this_gen == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "AtomicFile not valid");
+        return false;
+    }
+
+    AtomicFileExtends * this = (AtomicFileExtends *)this_gen;
+
+    if ( atomic_begin (this) == false || atomic_finish (this) == false )
+    {
+        return false;
+    }
+    sync_parent_dir (this->path);
+    return true;
+}
+
+bool commitAtomicFiles (AtomicFile * files, int count)
+{
+    if ( files == NULL || count < 0 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "files not valid");
+        return false;
+    }
+
+    bool         ret  = true;
+    bool       * ok   = (bool *)calloc (count, sizeof (bool));
+    GHashTable * dirs = g_hash_table_new_full (g_str_hash, g_str_equal, free, NULL);
+
+    // 모든 파일의 writeback 을 먼저 시작해 두면 fdatasync 들이 I/O 를 겹쳐서 기다린다.
+    for (int i = 0; i < count; i++)
+    {
+        ok[i] = files[i] != NULL && atomic_begin ((AtomicFileExtends *)files[i]);
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if ( ok[i] && atomic_finish ((AtomicFileExtends *)files[i]))
+        {
+            batch_add_dir (dirs, ((AtomicFileExtends *)files[i])->path);
+        }
+        else
+        {
+            ret = false;
+        }
+    }
+
+    GHashTableIter iter;
+    gpointer       key;
+
+    g_hash_table_iter_init (&iter, dirs);
+    while (g_hash_table_iter_next (&iter, &key, NULL))
+    {
+        sync_dir ((String)key);
+    }
+    g_hash_table_destroy (dirs);
+    free (ok);
+
+    return ret;
+}
+
+bool writeFileAtomic (String path, const void * data, size_t size)
+{
+    AtomicFile file = NewAtomicFile (path);
+    if ( file == NULL)
+    {
+        return false;
+    }
+
+    bool ret = writeAtomicFile (file, data, size) && commitAtomicFile (file);
+
+    DestroyAtomicFile (file);
+    return ret;
+}
+
+bool writeFilesAtomic (AtomicWrite * writes, int count)
+{
+    AtomicFile files[ATOMIC_GROUP_MAX];
+    bool       ret = true;
+
+    if ( writes == NULL || count < 0 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "writes not valid");
+        return false;
+    }
+
+    // 열린 임시 파일 수를 제한하기 위해 ATOMIC_GROUP_MAX 개씩 나누어 commit 한다.
+    for (int start = 0; start < count; start += ATOMIC_GROUP_MAX)
+    {
+        int n = MIN (count - start, ATOMIC_GROUP_MAX);
+
+        for (int i = 0; i < n; i++)
+        {
+            AtomicWrite * item = &writes[start + i];
+
+            files[i] = NewAtomicFile (item->path);
+            if ( files[i] == NULL)
+            {
+                item->result = (errno != 0) ? errno : EINVAL;
+            }
+            else if ( writeAtomicFile (files[i], item->data, item->size) == false )
+            {
+                item->result = errno;
+            }
+        }
+
+        if ( commitAtomicFiles (files, n) == false )
+        {
+            ret = false;
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            if ( files[i] != NULL)
+            {
+                AtomicFileExtends * this = (AtomicFileExtends *)files[i];
+
+                writes[start + i].result = this->done ? 0 : this->error;
+                DestroyAtomicFile (files[i]);
+            }
+        }
+    }
+
+    return ret;
+}
+
+// mapped file : 읽기 전용 mmap, 내용은 접근할 때 page fault 로 읽힌다.
+static int mapped_file_advice (mapped_file_advice_e advice)
+{
+    switch (advice)
+    {
+    case MAPPED_FILE_ADVICE_SEQUENTIAL:
+        return MADV_SEQUENTIAL;
+    case MAPPED_FILE_ADVICE_RANDOM:
+        return MADV_RANDOM;
+    case MAPPED_FILE_ADVICE_WILLNEED:
+        return MADV_WILLNEED;
+    case MAPPED_FILE_ADVICE_DONTNEED:
+        return MADV_DONTNEED;
+    default:
+        return MADV_NORMAL;
+    }
+}
+
+MappedFile NewMappedFile (String path, mapped_file_advice_e advice, bool hugePage)
+{
+    struct stat statbuf;
+
+    if ( path == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "path not valid");
+        return NULL;
+    }
+
+    int fd = open (path, O_RDONLY | O_CLOEXEC);
+    if ( fd == -1 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "can not open file : %s : %s", path, strerror (errno));
+        return NULL;
+    }
+
+    if ( fstat (fd, &statbuf) == -1 || S_ISREG (statbuf.st_mode) == false || (unsigned long long)statbuf.st_size > SIZE_MAX )
+    {
+        dlog_print (DLOG_INFO, "DIT", "can not map file : %s", path);
+        close (fd);
+        return NULL;
+    }
+
+    MappedFileExtends * this = (MappedFileExtends *)malloc (sizeof (MappedFileExtends));
+
+    this->file.getData = getMappedFileData;
+    this->file.getSize = getMappedFileSize;
+    this->file.Advise  = adviseMappedFile;
+
+    this->data = NULL;
+    this->size = (size_t)statbuf.st_size;
+
+    // 길이 0 인 mmap 은 실패하므로 빈 파일은 mapping 하지 않는다.
+    if ( this->size > 0 )
+    {
+        this->data = mmap (NULL, this->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if ( this->data == MAP_FAILED )
+        {
+            dlog_print (DLOG_INFO, "DIT", "mmap failed : %s : %s", path, strerror (errno));
+            close (fd);
+            free (this);
+            return NULL;
+        }
+
+        if ( advice != MAPPED_FILE_ADVICE_NORMAL )
+        {
+            madvise (this->data, this->size, mapped_file_advice (advice));
+        }
+        // hint 이므로 지원하지 않는 kernel (EINVAL) 에서는 무시한다.
+        if ( hugePage )
+        {
+            madvise (this->data, this->size, MADV_HUGEPAGE);
+        }
+    }
+
+    // mapping 은 fd 를 닫아도 유지된다.
+    close (fd);
+    return &this->file;
+}
+
+void DestroyMappedFile (MappedFile this_gen)
+{
+    if ( this_gen != NULL)
+    {
+        MappedFileExtends * this = (MappedFileExtends *)this_gen;
+
+        if ( this->data != NULL)
+        {
+            munmap (this->data, this->size);
+        }
+        free (this);
+    }
+}
+
+const void * getMappedFileData (MappedFile this_gen)
+{
+    if ( this_gen == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "MappedFile not valid");
+        return NULL;
+    }
+    return ((MappedFileExtends *)this_gen)->data;
+}
+
+size_t getMappedFileSize (MappedFile this_gen)
+{
+    if ( this_gen == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "MappedFile not valid");
+        return 0;
+    }
+    return ((MappedFileExtends *)this_gen)->size;
+}
+
+bool adviseMappedFile (MappedFile this_gen, mapped_file_advice_e advice, size_t offset, size_t length)
+{
+    if ( this_gen == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "MappedFile not valid");
+        return false;
+    }
+
+    MappedFileExtends * this = (MappedFileExtends *)this_gen;
+
+    if ( offset >= this->size )
+    {
+        dlog_print (DLOG_INFO, "DIT", "offset out of range");
+        return false;
+    }
+    if ( length == 0 || length > this->size - offset )
+    {
+        length = this->size - offset;
+    }
+
+    // madvise 는 page 경계에서 시작해야 한다.
+    size_t page  = (size_t)sysconf (_SC_PAGESIZE);
+    size_t start = offset & ~(page - 1);
+
+    if ( madvise ((char *)this->data + start, length + (offset - start), mapped_file_advice (advice)) == -1 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "madvise failed : %s", strerror (errno));
+        return false;
+    }
+    return true;
+}
+
+// copy job : worker thread 에서 copy engine 을 돌리고 chunk 마다 진행 상황 / 취소를 확인한다.
+static gpointer copy_job_run (gpointer data)
+{
+    CopyJobExtends * this = (CopyJobExtends *)data;
+
+    bool ret = copy_path_job (this->src, this->dst, COPY_FLAG_CLONE, this, NULL);
+
+    g_mutex_lock (&this->lock);
+    copy_job_report (this, g_get_monotonic_time ());
+    if ( ret )
+    {
+        this->progress.state = COPY_JOB_DONE;
+        this->progress.eta   = 0;
+    }
+    else
+    {
+        this->progress.state = g_atomic_int_get (&this->cancel) ? COPY_JOB_CANCELED : COPY_JOB_FAILED;
+    }
+
+    // 평균 속도는 전체 구간으로 다시 계산한다.
+    double elapsed = (g_get_monotonic_time () - this->start) / 1000000.0;
+    if ( elapsed > 0 )
+    {
+        this->progress.bytesPerSecond = this->progress.copied / elapsed;
+    }
+    CopyProgress progress = this->progress;
+    g_mutex_unlock (&this->lock);
+
+    if ( this->callback != NULL)
+    {
+        this->callback (&this->job, &progress, this->user_data);
+    }
+    return NULL;
+}
+
+CopyJob NewCopyJob (String src, String dst, CopyProgressCallback callback, int interval, void * data)
+{
+    if ( src == NULL || dst == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "src filename / dst filename not valid");
+        return NULL;
+    }
+
+    if ( access (src, F_OK) == -1 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "source file doesn't exist");
+        return NULL;
+    }
+
+    CopyJobExtends * this = (CopyJobExtends *)malloc (sizeof (CopyJobExtends));
+
+    this->job.Cancel      = cancelCopyJob;
+    this->job.Wait        = waitCopyJob;
+    this->job.getProgress = getCopyJobProgress;
+
+    this->src        = strdup (src);
+    this->dst        = strdup (dst);
+    this->callback   = callback;
+    this->user_data  = data;
+    this->interval   = (gint64)((interval > 0) ? interval : COPY_JOB_INTERVAL) * 1000;
+    this->start      = g_get_monotonic_time ();
+    this->lastTime   = this->start;
+    this->lastCopied = 0;
+    this->cancel     = 0;
+    this->joined     = false;
+    g_mutex_init (&this->lock);
+
+    memset (&this->progress, 0, sizeof (CopyProgress));
+    this->progress.state = COPY_JOB_RUNNING;
+    this->progress.eta   = -1;
+
+    this->thread = g_thread_try_new ("CopyJob", copy_job_run, this, NULL);
+    if ( this->thread == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "can not start copy thread");
+        g_mutex_clear (&this->lock);
+        free (this->src);
+        free (this->dst);
+        free (this);
+        return NULL;
+    }
+
+    return &this->job;
+}
+
+void DestroyCopyJob (CopyJob this_gen)
+{
+    if ( this_gen != NULL)
+    {
+        CopyJobExtends * this = (CopyJobExtends *)this_gen;
+
+        cancelCopyJob (this_gen);
+        waitCopyJob (this_gen);
+
+        g_mutex_clear (&this->lock);
+        free (this->src);
+        free (this->dst);
+        free (this);
+    }
+}
+
+bool cancelCopyJob (CopyJob this_gen)
+{
+    if ( this_gen == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "NULL module");
+        return false;
+    }
+
+    CopyJobExtends * this = (CopyJobExtends *)this_gen;
+
+    g_atomic_int_set (&this->cancel, 1);
+    return true;
+}
+
+bool waitCopyJob (CopyJob this_gen)
+{
+    if ( this_gen == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "NULL module");
+        return false;
+    }
+
+    CopyJobExtends * this = (CopyJobExtends *)this_gen;
+
+    if ( this->joined == false )
+    {
+        g_thread_join (this->thread);
+        this->joined = true;
+    }
+
+    return this->progress.state == COPY_JOB_DONE;
+}
+
+CopyProgress getCopyJobProgress (CopyJob this_gen)
+{
+    CopyProgress progress;
+
+    if ( this_gen == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "NULL module");
+        memset (&progress, 0, sizeof (CopyProgress));
+        progress.state = COPY_JOB_FAILED;
+        return progress;
+    }
+
+    CopyJobExtends * this = (CopyJobExtends *)this_gen;
+
+    g_mutex_lock (&this->lock);
+    progress = this->progress;
+    g_mutex_unlock (&this->lock);
+
+    return progress;
+}
+
+// search matcher : pattern 은 추가될 때 한번만 compile 하여 모든 entry 에 재사용한다.
+typedef enum
+{
+    MATCH_EXACT,
+    MATCH_PREFIX,
+    MATCH_SUFFIX,
+    MATCH_CONTAINS,
+    MATCH_GLOB,
+    MATCH_REGEX
+
+} MatchKind;
+
+typedef struct _MatchPattern
+{
+    MatchKind kind;
+    String    text;       // EXACT / PREFIX / SUFFIX / CONTAINS 의 literal, GLOB 의 원본 pattern
+    size_t    len;
+    String    prefix;     // GLOB / REGEX 의 literal prefix
+    size_t    prefixLen;
+    String    suffix;     // GLOB 의 literal suffix
+    size_t    suffixLen;
+    GRegex  * regex;
+
+} MatchPattern;
+
+static void deleteMatchPattern (gpointer data)
+{
+    MatchPattern * match = (MatchPattern *)data;
+
+    if ( match->regex != NULL)
+    {
+        g_regex_unref (match->regex);
+    }
+    free (match->text);
+    free (match->prefix);
+    free (match->suffix);
+    free (match);
+}
+
+// 첫 글자를 memchr 로 찾은 후 나머지를 비교한다.
+static bool find_literal (const char * name, size_t len, const char * text, size_t textLen)
+{
+    const char * pos = name;
+    const char * end = name + len;
+
+    if ( textLen == 0 )
+    {
+        return true;
+    }
+
+    while ((size_t)(end - pos) >= textLen && (pos = memchr (pos, text[0], (end - pos) - textLen + 1)) != NULL)
+    {
+        if ( memcmp (pos + 1, text + 1, textLen - 1) == 0 )
+        {
+            return true;
+        }
+        pos++;
+    }
+    return false;
+}
+
+static MatchPattern * compile_glob (String pattern)
+{
+    MatchPattern * match = calloc (1, sizeof (MatchPattern));
+    size_t len   = strlen (pattern);
+    size_t first = strcspn (pattern, "*?[\\");
+    size_t last  = len;
+    size_t stars = 0;
+
+    while (last > 0 && strchr ("*?[]\\", pattern[last - 1]) == NULL)
+    {
+        last--;
+    }
+    for (size_t i = 0; i < len; i++)
+    {
+        stars += (pattern[i] == '*');
+    }
+
+    if ( first == len )
+    {
+        match->kind = MATCH_EXACT;
+        match->text = strndup (pattern, len);
+    }
+    else if ( strcspn (pattern, "?[]\\") != len )
+    {
+        match->kind = MATCH_GLOB;
+    }
+    else if ( stars == 1 && pattern[len - 1] == '*' )
+    {
+        match->kind = MATCH_PREFIX;
+        match->text = strndup (pattern, len - 1);
+    }
+    else if ( stars == 1 && pattern[0] == '*' )
+    {
+        match->kind = MATCH_SUFFIX;
+        match->text = strndup (pattern + 1, len - 1);
+    }
+    else if ( stars == 2 && len >= 2 && pattern[0] == '*' && pattern[len - 1] == '*' )
+    {
+        match->kind = MATCH_CONTAINS;
+        match->text = strndup (pattern + 1, len - 2);
+    }
+    else
+    {
+        match->kind = MATCH_GLOB;
+    }
+
+    if ( match->kind == MATCH_GLOB )
+    {
+        match->text      = strdup (pattern);
+        match->prefix    = strndup (pattern, first);
+        match->prefixLen = first;
+        match->suffix    = strdup (pattern + last);
+        match->suffixLen = len - last;
+    }
+    match->len = strlen (match->text);
+
+    return match;
+}
+
+static MatchPattern * compile_regex (String pattern)
+{
+    // '$' 가 이름 끝의 개행 앞에서 맞지 않도록 G_REGEX_DOLLAR_ENDONLY 를 준다.
+    GError * error    = NULL;
+    String   anchored = g_strdup_printf ("(?:%s)$", pattern);
+    GRegex * regex    = g_regex_new (anchored, G_REGEX_OPTIMIZE | G_REGEX_ANCHORED | G_REGEX_DOLLAR_ENDONLY, 0, &error);
+
+    g_free (anchored);
+    if ( regex == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "invalid regex : %s", error != NULL ? error->message : pattern);
+        if ( error != NULL)
+        {
+            g_error_free (error);
+        }
+        return NULL;
+    }
+
+    MatchPattern * match = calloc (1, sizeof (MatchPattern));
+    String         start = (pattern[0] == '^') ? pattern + 1 : pattern;
+    size_t         len   = strcspn (start, "\\.^$|?*+()[]{}");
+
+    // 수량자가 붙은 마지막 글자는 literal 이 아니다.
+    if ( len > 0 && start[len] != '\0' && strchr ("?*{", start[len]) != NULL)
+    {
+        len--;
+    }
+    if ( strchr (pattern, '|') != NULL)
+    {
+        len = 0;
+    }
+
+    match->kind      = MATCH_REGEX;
+    match->regex     = regex;
+    match->prefix    = strndup (start, len);
+    match->prefixLen = len;
+
+    return match;
+}
+
+static bool match_pattern (MatchPattern * match, const char * name, size_t len)
+{
+    switch (match->kind)
+    {
+    case MATCH_EXACT:
+        return len == match->len && memcmp (name, match->text, len) == 0;
+
+    case MATCH_PREFIX:
+        return len >= match->len && memcmp (name, match->text, match->len) == 0;
+
+    case MATCH_SUFFIX:
+        return len >= match->len && memcmp (name + len - match->len, match->text, match->len) == 0;
+
+    case MATCH_CONTAINS:
+        return find_literal (name, len, match->text, match->len);
+
+    case MATCH_GLOB:
+        if ( len < match->prefixLen + match->suffixLen
+             || memcmp (name, match->prefix, match->prefixLen) != 0
+             || memcmp (name + len - match->suffixLen, match->suffix, match->suffixLen) != 0 )
+        {
+            return false;
+        }
+        return fnmatch (match->text, name, 0) == 0;
+
+    case MATCH_REGEX:
+        if ( len < match->prefixLen || memcmp (name, match->prefix, match->prefixLen) != 0 )
+        {
+            return false;
+        }
+        return g_regex_match (match->regex, name, 0, NULL);
+
+    default:
+        return false;
+    }
+}
+
+// type -> 이름 -> stat 이 필요한 조건 순으로 비용이 싼 것부터 검사한다.
+static bool matcher_match (SearchMatcherExtends * this, int dirfd, const char * name, unsigned char type)
+{
+    switch (this->type)
+    {
+    case SEARCH_TYPE_FILE:
+        if ( type != DT_REG )
+        {
+            return false;
+        }
+        break;
+
+    case SEARCH_TYPE_DIRECTORY:
+        if ( type != DT_DIR )
+        {
+            return false;
+        }
+        break;
+
+    case SEARCH_TYPE_LINK:
+        if ( type != DT_LNK )
+        {
+            return false;
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    if ( this->patterns != NULL)
+    {
+        size_t len     = strlen (name);
+        bool   matched = false;
+
+        for (GList * iter = this->patterns; iter != NULL && matched == false; iter = iter->next)
+        {
+            matched = match_pattern ((MatchPattern *)iter->data, name, len);
+        }
+
+        if ( matched == false )
+        {
+            return false;
+        }
+    }
+
+    if ( this->minSize >= 0 || this->maxSize >= 0 || this->after > 0 || this->before > 0 )
+    {
+        struct stat statbuf;
+
+        if ( fstatat (dirfd, name, &statbuf, AT_SYMLINK_NOFOLLOW) == -1 )
+        {
+            return false;
+        }
+        if ((this->minSize >= 0 && statbuf.st_size < this->minSize) || (this->maxSize >= 0 && statbuf.st_size > this->maxSize))
+        {
+            return false;
+        }
+        if ((this->after > 0 && statbuf.st_mtime < this->after) || (this->before > 0 && statbuf.st_mtime > this->before))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// file search : openat 기반 work-stealing directory walker
+typedef struct _SearchContext SearchContext;
+
+static bool fileindex_answer (SearchContext * context);
+static void deleteIndexEntry (gpointer data);
+
+// collect mode 에서 수집하는 entry (file index 생성용)
+typedef struct _IndexEntry
+{
+    String        path;  // root 기준 상대 경로
+    size_t        name;  // path 안에서 이름의 시작 위치
+    unsigned char type;
+    int64_t       mtime; // directory 의 mtime (ns)
+
+} IndexEntry;
+
+typedef struct _SearchWorker
+{
+    SearchContext * context;
+    GThread       * thread;
+    GMutex          lock;
+    GQueue          queue;  // 탐색할 디렉토리 (root 기준 상대 경로)
+    GList         * result;
+    int             index;
+    char          * dirent; // getdents64 buffer
+
+} SearchWorker;
+
+struct linux_dirent64
+{
+    uint64_t       d_ino;
+    int64_t        d_off;
+    unsigned short d_reclen;
+    unsigned char  d_type;
+    char           d_name[];
+};
+
+struct _SearchContext
+{
+    String                 root;
+    int                    rootfd;
+    String                 name;
+    SearchMatcherExtends * matcher;
+    int                    workerCount;
+    SearchWorker         * workers;
+    GMutex                 lock;
+    GCond                  cond;
+    volatile gint          pending; // 처리가 끝나지 않은 디렉토리 수
+    volatile gint          queued;  // queue 에 대기중인 디렉토리 수
+    volatile gint          idle;
+    volatile gint          stop;
+
+    GMutex                 resultLock;
+    GList                * result;
+    SearchCallback         callback;
+    void                 * user_data;
+    int                    maxResults;
+    int                    found;
+    bool                   collect; // 모든 entry 를 IndexEntry 로 수집한다.
+
+};
+
+static String join_path (String dir, String name)
+{
+    if ( strcmp (dir, ".") == 0 )
+    {
+        return strdup (name);
+    }
+
+    size_t dirlen = strlen (dir);
+    size_t len    = dirlen + strlen (name) + 2;
+    String path   = malloc (len);
+
+    if ( dirlen > 0 && dir[dirlen - 1] == '/' )
+    {
+        snprintf (path, len, "%s%s", dir, name);
+    }
+    else
+    {
+        snprintf (path, len, "%s/%s", dir, name);
+    }
+    return path;
+}
+
+static void search_push (SearchWorker * worker, String path)
+{
+    SearchContext * context = worker->context;
+
+    g_atomic_int_inc (&context->pending);
+
+    g_mutex_lock (&worker->lock);
+    g_queue_push_tail (&worker->queue, path);
+    g_mutex_unlock (&worker->lock);
+
+    g_atomic_int_inc (&context->queued);
+
+    if ( g_atomic_int_get (&context->idle) > 0 )
+    {
+        g_mutex_lock (&context->lock);
+        g_cond_signal (&context->cond);
+        g_mutex_unlock (&context->lock);
+    }
+}
+
+// 자신의 queue 는 뒤에서 (depth first), 다른 worker 의 queue 는 앞에서 가져온다.
+static String search_pop (SearchWorker * worker)
+{
+    SearchContext * context = worker->context;
+    String path;
+
+    g_mutex_lock (&worker->lock);
+    path = g_queue_pop_tail (&worker->queue);
+    g_mutex_unlock (&worker->lock);
+
+    for (int i = 1; path == NULL && i < context->workerCount; i++)
+    {
+        SearchWorker * victim = &context->workers[(worker->index + i) % context->workerCount];
+
+        g_mutex_lock (&victim->lock);
+        path = g_queue_pop_head (&victim->queue);
+        g_mutex_unlock (&victim->lock);
+    }
+
+    if ( path != NULL)
+    {
+        g_atomic_int_add (&context->queued, -1);
+    }
+    return path;
+}
+
+static void search_stop (SearchContext * context)
+{
+    g_atomic_int_set (&context->stop, 1);
+
+    g_mutex_lock (&context->lock);
+    g_cond_broadcast (&context->cond);
+    g_mutex_unlock (&context->lock);
+}
+
+static void search_found (SearchWorker * worker, String dir, String name, bool isLink)
+{
+    SearchContext * context = worker->context;
+    String relpath = join_path (dir, name);
+    String pPath   = join_path (context->root, relpath);
+
+    free (relpath);
+
+    if ( isLink )
+    {
+        String resolved = realpath (pPath, NULL);
+        free (pPath);
+        pPath = resolved;
+    }
+
+    if ( pPath == NULL)
+    {
+        return;
+    }
+
+    if ( context->callback == NULL)
+    {
+        worker->result = g_list_prepend (worker->result, (gpointer)pPath);
+        return;
+    }
+
+    // callback 은 한번에 하나의 thread 에서만 호출되며 path 는 호출 후 바로 해제한다.
+    g_mutex_lock (&context->resultLock);
+    if ( g_atomic_int_get (&context->stop) == 0 )
+    {
+        bool next = context->callback (pPath, context->user_data);
+
+        context->found++;
+        if ( next == false || (context->maxResults > 0 && context->found >= context->maxResults))
+        {
+            search_stop (context);
+        }
+    }
+    g_mutex_unlock (&context->resultLock);
+
+    free (pPath);
+}
+
+static int64_t stat_mtime (struct stat * statbuf)
+{
+    return (int64_t)statbuf->st_mtim.tv_sec * 1000000000 + statbuf->st_mtim.tv_nsec;
+}
+
+static void search_collect (SearchWorker * worker, int fd, String dir, String name, unsigned char type)
+{
+    IndexEntry * item = (IndexEntry *)malloc (sizeof (IndexEntry));
+    struct stat statbuf;
+
+    item->path  = join_path (dir, name);
+    item->name  = strlen (item->path) - strlen (name);
+    item->type  = type;
+    item->mtime = 0;
+
+    if ( type == DT_DIR && fstatat (fd, name, &statbuf, AT_SYMLINK_NOFOLLOW) == 0 )
+    {
+        item->mtime = stat_mtime (&statbuf);
+    }
+
+    worker->result = g_list_prepend (worker->result, item);
+}
+
+static void search_directory (SearchWorker * worker, String path)
+{
+    SearchContext * context = worker->context;
+    struct stat statbuf;
+    long        nread;
+
+    int fd = openat (context->rootfd, path, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if ( fd == -1 )
+    {
+        return;
+    }
+
+    // readdir 대신 getdents64 로 한번에 많은 entry 를 읽는다.
+    while (g_atomic_int_get (&context->stop) == 0 && (nread = syscall (SYS_getdents64, fd, worker->dirent, SEARCH_DIRENT_SIZE)) > 0)
+    {
+        for (long pos = 0; pos < nread && g_atomic_int_get (&context->stop) == 0;)
+        {
+            struct linux_dirent64 * entry = (struct linux_dirent64 *)(worker->dirent + pos);
+            unsigned char type = entry->d_type;
+
+            pos += entry->d_reclen;
+
+            /* ignore . and .. */
+            if ( strcmp (".", entry->d_name) == 0 || strcmp ("..", entry->d_name) == 0 )
+            {
+                continue;
+            }
+
+            // d_type 을 지원하지 않는 파일 시스템에서만 stat 을 호출한다.
+            if ( type == DT_UNKNOWN )
+            {
+                if ( fstatat (fd, entry->d_name, &statbuf, AT_SYMLINK_NOFOLLOW) == -1 )
+                {
+                    continue;
+                }
+                type = IFTODT(statbuf.st_mode);
+            }
+
+            if ( context->collect )
+            {
+                search_collect (worker, fd, path, entry->d_name, type);
+            }
+            else if ( context->matcher != NULL ? matcher_match (context->matcher, fd, entry->d_name, type) : strcmp (entry->d_name, context->name) == 0 )
+            {
+                search_found (worker, path, entry->d_name, type == DT_LNK);
+            }
+
+            if ( type == DT_DIR )
+            {
+                search_push (worker, join_path (path, entry->d_name));
+            }
+        }
+    }
+
+    close (fd);
+}
+
+static gpointer search_worker_run (gpointer data)
+{
+    SearchWorker  * worker  = (SearchWorker *)data;
+    SearchContext * context = worker->context;
+    String path;
+    bool   done = false;
+
+    while (done == false && g_atomic_int_get (&context->stop) == 0)
+    {
+        path = search_pop (worker);
+        if ( path != NULL)
+        {
+            search_directory (worker, path);
+            free (path);
+
+            if ( g_atomic_int_dec_and_test (&context->pending))
+            {
+                g_mutex_lock (&context->lock);
+                g_cond_broadcast (&context->cond);
+                g_mutex_unlock (&context->lock);
+            }
+            continue;
+        }
+
+        g_mutex_lock (&context->lock);
+        g_atomic_int_inc (&context->idle);
+        while (g_atomic_int_get (&context->queued) == 0 && g_atomic_int_get (&context->pending) > 0 && g_atomic_int_get (&context->stop) == 0)
+        {
+            g_cond_wait (&context->cond, &context->lock);
+        }
+        g_atomic_int_add (&context->idle, -1);
+        done = g_atomic_int_get (&context->pending) == 0;
+        g_mutex_unlock (&context->lock);
+    }
+    return NULL;
+}
+
+static bool search_run (String src, SearchContext * context)
+{
+    if ( src == NULL || (context->name == NULL && context->matcher == NULL && context->collect == false))
+    {
+        dlog_print (DLOG_INFO, "DIT", "src path / search name not valid");
+        return false;
+    }
+
+    context->root = realpath (src, NULL);
+    if ( context->root == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "target source file doesn't exist");
+        return false;
+    }
+
+    // 이름 검색은 등록된 file index 가 있으면 disk 를 탐색하지 않는다.
+    if ( context->name != NULL && context->matcher == NULL && fileindex_answer (context))
+    {
+        free (context->root);
+        return true;
+    }
+
+    if ((context->rootfd = open (context->root, O_RDONLY | O_DIRECTORY | O_CLOEXEC)) == -1 )
+    {
+        free (context->root);
+        dlog_print (DLOG_INFO, "DIT", "target source file doesn't exist");
+        return false;
+    }
+
+    if ( context->workerCount <= 0 )
+    {
+        context->workerCount = (int)g_get_num_processors ();
+    }
+
+    context->workers = calloc (context->workerCount, sizeof (SearchWorker));
+    g_mutex_init (&context->lock);
+    g_mutex_init (&context->resultLock);
+    g_cond_init (&context->cond);
+
+    for (int i = 0; i < context->workerCount; i++)
+    {
+        context->workers[i].context = context;
+        context->workers[i].index   = i;
+        context->workers[i].dirent  = malloc (SEARCH_DIRENT_SIZE);
+        g_mutex_init (&context->workers[i].lock);
+        g_queue_init (&context->workers[i].queue);
+    }
+
+    search_push (&context->workers[0], strdup ("."));
+
+    for (int i = 1; i < context->workerCount; i++)
+    {
+        context->workers[i].thread = g_thread_new ("DIT-search", search_worker_run, &context->workers[i]);
+    }
+    search_worker_run (&context->workers[0]);
+
+    for (int i = context->workerCount - 1; i >= 0; i--)
+    {
+        SearchWorker * worker = &context->workers[i];
+        String path;
+
+        if ( worker->thread != NULL)
+        {
+            g_thread_join (worker->thread);
+        }
+        while ((path = g_queue_pop_head (&worker->queue)) != NULL)
+        {
+            free (path);
+        }
+        g_mutex_clear (&worker->lock);
+        free (worker->dirent);
+
+        context->result = g_list_concat (g_list_reverse (worker->result), context->result);
+    }
+
+    g_cond_clear (&context->cond);
+    g_mutex_clear (&context->resultLock);
+    g_mutex_clear (&context->lock);
+    free (context->workers);
+    close (context->rootfd);
+    free (context->root);
+
+    return true;
+}
+
+GList * searchFile (String src, String dst)
+{
+    SearchContext context;
+
+    memset (&context, 0, sizeof (SearchContext));
+    context.name        = dst;
+    context.workerCount = 1;
+
+    search_run (src, &context);
+    return context.result;
+}
+
+GList * searchFileParallel (String src, String dst, int threadCount)
+{
+    SearchContext context;
+
+    memset (&context, 0, sizeof (SearchContext));
+    context.name        = dst;
+    context.workerCount = threadCount;
+
+    search_run (src, &context);
+    return context.result;
+}
+
+bool searchFileForeach (String src, String dst, int threadCount, int maxResults, SearchCallback callback, void * user_data)
+{
+    SearchContext context;
+
+    if ( callback == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "NULL callback");
+        return false;
+    }
+
+    memset (&context, 0, sizeof (SearchContext));
+    context.name        = dst;
+    context.workerCount = threadCount;
+    context.maxResults  = maxResults;
+    context.callback    = callback;
+    context.user_data   = user_data;
+
+    return search_run (src, &context);
+}
+
+GList * searchFileMatch (String src, SearchMatcher matcher, int threadCount)
+{
+    SearchContext context;
+
+    memset (&context, 0, sizeof (SearchContext));
+    context.matcher     = (SearchMatcherExtends *)matcher;
+    context.workerCount = threadCount;
+
+    search_run (src, &context);
+    return context.result;
+}
+
+bool searchFileMatchForeach (String src, SearchMatcher matcher, int threadCount, int maxResults, SearchCallback callback, void * user_data)
+{
+    SearchContext context;
+
+    if ( callback == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "NULL callback");
+        return false;
+    }
+
+    memset (&context, 0, sizeof (SearchContext));
+    context.matcher     = (SearchMatcherExtends *)matcher;
+    context.workerCount = threadCount;
+    context.maxResults  = maxResults;
+    context.callback    = callback;
+    context.user_data   = user_data;
+
+    return search_run (src, &context);
+}
+
+SearchMatcher NewSearchMatcher (void)
+{
+    SearchMatcherExtends * this = (SearchMatcherExtends *)malloc (sizeof (SearchMatcherExtends));
+
+    this->matcher.addGlob         = addSearchMatcherGlob;
+    this->matcher.addRegex        = addSearchMatcherRegex;
+    this->matcher.setSize         = setSearchMatcherSize;
+    this->matcher.setModifiedTime = setSearchMatcherModifiedTime;
+    this->matcher.setType         = setSearchMatcherType;
+
+    this->patterns = NULL;
+    this->type     = SEARCH_TYPE_ANY;
+    this->minSize  = -1;
+    this->maxSize  = -1;
+    this->after    = 0;
+    this->before   = 0;
+
+    return &this->matcher;
+}
+
+void DestroySearchMatcher (SearchMatcher this_gen)
+{
+    if ( this_gen != NULL)
+    {
+        SearchMatcherExtends * this = (SearchMatcherExtends *)this_gen;
+
+        g_list_free_full (this->patterns, deleteMatchPattern);
+        free (this);
+    }
+}
+
+bool addSearchMatcherGlob (SearchMatcher this_gen, String pattern)
+{
+    if ( this_gen != NULL && pattern != NULL)
+    {
+        SearchMatcherExtends * this = (SearchMatcherExtends *)this_gen;
+
+        this->patterns = g_list_append (this->patterns, compile_glob (pattern));
+        return true;
+    }
+    dlog_print (DLOG_INFO, "DIT", "NULL module / pattern");
+    return false;
+}
+
+bool addSearchMatcherRegex (SearchMatcher this_gen, String pattern)
+{
+    if ( this_gen != NULL && pattern != NULL)
+    {
+        SearchMatcherExtends * this = (SearchMatcherExtends *)this_gen;
+
+        MatchPattern * match = compile_regex (pattern);
+        if ( match == NULL)
+        {
+            return false;
+        }
+
+        this->patterns = g_list_append (this->patterns, match);
+        return true;
+    }
+    dlog_print (DLOG_INFO, "DIT", "NULL module / pattern");
+    return false;
+}
+
+bool setSearchMatcherSize (SearchMatcher this_gen, long long minSize, long long maxSize)
+{
+    if ( this_gen != NULL)
+    {
+        SearchMatcherExtends * this = (SearchMatcherExtends *)this_gen;
+
+        this->minSize = minSize;
+        this->maxSize = maxSize;
+        return true;
+    }
+    dlog_print (DLOG_INFO, "DIT", "NULL module");
+    return false;
+}
+
+bool setSearchMatcherModifiedTime (SearchMatcher this_gen, time_t after, time_t before)
+{
+    if ( this_gen != NULL)
+    {
+        SearchMatcherExtends * this = (SearchMatcherExtends *)this_gen;
+
+        this->after  = after;
+        this->before = before;
+        return true;
+    }
+    dlog_print (DLOG_INFO, "DIT", "NULL module");
+    return false;
+}
+
+bool setSearchMatcherType (SearchMatcher this_gen, search_type_e type)
+{
+    if ( this_gen != NULL)
+    {
+        SearchMatcherExtends * this = (SearchMatcherExtends *)this_gen;
+
+        this->type = type;
+        return true;
+    }
+    dlog_print (DLOG_INFO, "DIT", "NULL module");
+    return false;
+}
+
+// tree : directory 를 node 로 만들어 worker 들이 나누어 처리하고, 하위 node 가 모두 끝난 directory 를 마무리한다.
+typedef enum
+{
+    TREE_COPY,
+    TREE_DELETE
+
+} TreeOperation;
+
+typedef struct _TreeNode TreeNode;
+struct _TreeNode
+{
+    TreeNode      * parent;
+    String          path;    // root 기준 상대 경로
+    volatile gint   pending; // 자신 + 처리가 끝나지 않은 하위 directory 수
+    mode_t          mode;
+    struct timespec times[2];
+};
+
+typedef struct _TreeContext
+{
+    TreeOperation  operation;
+    unsigned int   flags;    // COPY_FLAG_*
+    String         srcRoot;
+    String         dstRoot;
+    int            srcfd;
+    int            dstfd;
+    GMutex         lock;
+    GCond          cond;
+    GQueue         stack;    // TreeNode *, 깊이 우선으로 처리하여 대기 node 수를 줄인다.
+    int            busy;
+    volatile gint  failed;
+    volatile gint  error;
+
+} TreeContext;
+
+static void tree_fail (TreeContext * context, int error, String path)
+{
+    if ( g_atomic_int_compare_and_exchange (&context->error, 0, error))
+    {
+        dlog_print (DLOG_INFO, "DIT", "tree operation failed : %s : %s", path, strerror (error));
+    }
+    g_atomic_int_set (&context->failed, 1);
+}
+
+static TreeNode * tree_node_new (TreeNode * parent, String path, struct stat * statbuf)
+{
+    TreeNode * node = (TreeNode *)malloc (sizeof (TreeNode));
+
+    node->parent  = parent;
+    node->path    = path;
+    node->pending = 1;
+    node->mode    = 0;
+
+    // 삭제할 때는 directory 의 속성이 필요 없으므로 statbuf 가 NULL 이다.
+    if ( statbuf != NULL)
+    {
+        node->mode     = statbuf->st_mode;
+        node->times[0] = statbuf->st_atim;
+        node->times[1] = statbuf->st_mtim;
+    }
+
+    if ( parent != NULL)
+    {
+        g_atomic_int_inc (&parent->pending);
+    }
+    return node;
+}
+
+static void tree_push (TreeContext * context, TreeNode * node)
+{
+    g_mutex_lock (&context->lock);
+    g_queue_push_tail (&context->stack, node);
+    g_cond_signal (&context->cond);
+    g_mutex_unlock (&context->lock);
+}
+
+// 하위 항목이 모두 처리된 directory 를 마무리한다 : 복사는 권한 / 시간 설정, 삭제는 rmdir.
+static void tree_finish (TreeContext * context, TreeNode * node)
+{
+    bool root = (node->parent == NULL);
+
+    if ( context->operation == TREE_DELETE )
+    {
+        if ((root ? rmdir (context->srcRoot) : unlinkat (context->srcfd, node->path, AT_REMOVEDIR)) == -1 )
+        {
+            tree_fail (context, errno, node->path);
+        }
+        return;
+    }
+
+    if ( g_atomic_int_get (&context->failed))
+    {
+        return;
+    }
+
+    if ( fchmodat (context->dstfd, node->path, node->mode & 07777, 0) == -1 )
+    {
+        tree_fail (context, errno, node->path);
+    }
+    if ((context->flags & COPY_FLAG_PRESERVE) && utimensat (context->dstfd, node->path, node->times, 0) == -1 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "can not preserve attributes : %s : %s", node->path, strerror (errno));
+    }
+    if ( context->flags & COPY_FLAG_SYNC )
+    {
+        int fd = openat (context->dstfd, node->path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if ( fd != -1 )
+        {
+            fsync (fd);
+            close (fd);
+        }
+    }
+}
+
+static void tree_release (TreeContext * context, TreeNode * node)
+{
+    while (node != NULL && g_atomic_int_dec_and_test (&node->pending))
+    {
+        TreeNode * parent = node->parent;
+
+        tree_finish (context, node);
+        free (node->path);
+        free (node);
+        node = parent;
+    }
+}
+
+// directory 가 아닌 항목 하나를 복사한다.
+static bool tree_copy_entry (TreeContext * context, int srcdir, String srcName, int dstdir, String dstName)
+{
+    struct stat statbuf;
+    char        target[PATH_MAX];
+
+    if ( fstatat (srcdir, srcName, &statbuf, AT_SYMLINK_NOFOLLOW) == -1 )
+    {
+        return false;
+    }
+
+    if ( S_ISREG (statbuf.st_mode))
+    {
+        int in = openat (srcdir, srcName, O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+        if ( in == -1 )
+        {
+            return false;
+        }
+
+        // 대상에 있는 symlink 를 따라가지 않으며, 실패하면 이번에 새로 만든 파일만 지운다.
+        int  out     = openat (dstdir, dstName, O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC, statbuf.st_mode & 0777);
+        bool created = (out != -1);
+
+        if ( out == -1 && errno == EEXIST )
+        {
+            out = openat (dstdir, dstName, O_WRONLY | O_NOFOLLOW | O_CLOEXEC);
+        }
+        if ( out == -1 )
+        {
+            int error = errno;
+            close (in);
+            errno = error;
+            return false;
+        }
+
+        bool ret = (created || ftruncate (out, 0) == 0) && copy_fd_all (in, out, srcName, dstName, &statbuf, context->flags | COPY_FLAG_CLONE, NULL, NULL);
+        int  error = errno;
+
+        close (in);
+        if ( close (out) == -1 && ret )
+        {
+            ret   = false;
+            error = errno;
+        }
+        if ( ret == false && created )
+        {
+            unlinkat (dstdir, dstName, 0);
+        }
+        errno = error;
+        return ret;
+    }
+
+    if ( S_ISLNK (statbuf.st_mode))
+    {
+        ssize_t len = readlinkat (srcdir, srcName, target, sizeof (target) - 1);
+        if ( len == -1 )
+        {
+            return false;
+        }
+        target[len] = '\0';
+
+        if ( symlinkat (target, dstdir, dstName) == -1 )
+        {
+            if ( errno != EEXIST || unlinkat (dstdir, dstName, 0) == -1 || symlinkat (target, dstdir, dstName) == -1 )
+            {
+                return false;
+            }
+        }
+    }
+    else if ( mknodat (dstdir, dstName, statbuf.st_mode, statbuf.st_rdev) == -1 )
+    {
+        return false;
+    }
+
+    if ( context->flags & COPY_FLAG_PRESERVE )
+    {
+        struct timespec times[2] = {statbuf.st_atim, statbuf.st_mtim};
+
+        utimensat (dstdir, dstName, times, AT_SYMLINK_NOFOLLOW);
+    }
+    return true;
+}
+
+static void tree_directory (TreeContext * context, TreeNode * node, char * dirent)
+{
+    struct stat statbuf;
+    long        nread;
+    int         dstdir = -1;
+
+    int srcdir = openat (context->srcfd, node->path, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if ( srcdir == -1 )
+    {
+        tree_fail (context, errno, node->path);
+        tree_release (context, node);
+        return;
+    }
+
+    if ( context->operation == TREE_COPY && (dstdir = openat (context->dstfd, node->path, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC)) == -1 )
+    {
+        tree_fail (context, errno, node->path);
+        close (srcdir);
+        tree_release (context, node);
+        return;
+    }
+
+    // 복사는 실패하면 바로 멈추고, 삭제는 가능한 만큼 계속 지운다.
+    while ((context->operation == TREE_DELETE || g_atomic_int_get (&context->failed) == 0)
+           && (nread = syscall (SYS_getdents64, srcdir, dirent, SEARCH_DIRENT_SIZE)) > 0)
+    {
+        for (long pos = 0; pos < nread;)
+        {
+            struct linux_dirent64 * entry = (struct linux_dirent64 *)(dirent + pos);
+            unsigned char           type  = entry->d_type;
+
+            pos += entry->d_reclen;
+
+            if ( strcmp (".", entry->d_name) == 0 || strcmp ("..", entry->d_name) == 0 )
+            {
+                continue;
+            }
+
+            // 복사는 directory 의 권한 / 시간이 필요하므로 directory 는 항상 stat 한다.
+            if ( type == DT_UNKNOWN || (type == DT_DIR && context->operation == TREE_COPY))
+            {
+                if ( fstatat (srcdir, entry->d_name, &statbuf, AT_SYMLINK_NOFOLLOW) == -1 )
+                {
+                    tree_fail (context, errno, entry->d_name);
+                    continue;
+                }
+                type = IFTODT(statbuf.st_mode);
+            }
+
+            if ( type == DT_DIR )
+            {
+                // 원본이 읽기 전용이어도 내용을 채울 수 있도록 권한은 마무리할 때 맞춘다.
+                if ( context->operation == TREE_COPY && mkdirat (dstdir, entry->d_name, S_IRWXU) == -1 && errno != EEXIST )
+                {
+                    tree_fail (context, errno, entry->d_name);
+                    continue;
+                }
+                tree_push (context, tree_node_new (node, join_path (node->path, entry->d_name), (context->operation == TREE_COPY) ? &statbuf : NULL));
+            }
+            else if ( context->operation == TREE_COPY )
+            {
+                if ( tree_copy_entry (context, srcdir, entry->d_name, dstdir, entry->d_name) == false )
+                {
+                    tree_fail (context, errno, entry->d_name);
+                }
+            }
+            else if ( unlinkat (srcdir, entry->d_name, 0) == -1 )
+            {
+                tree_fail (context, errno, entry->d_name);
+            }
+        }
+    }
+
+    close (srcdir);
+    if ( dstdir != -1 )
+    {
+        close (dstdir);
+    }
+    tree_release (context, node);
+}
+
+static gpointer tree_worker_run (gpointer data)
+{
+    TreeContext * context = (TreeContext *)data;
+    char        * dirent  = (char *)malloc (SEARCH_DIRENT_SIZE);
+
+    g_mutex_lock (&context->lock);
+    while (true)
+    {
+        while (g_queue_is_empty (&context->stack) && context->busy > 0)
+        {
+            g_cond_wait (&context->cond, &context->lock);
+        }
+
+        TreeNode * node = (TreeNode *)g_queue_pop_tail (&context->stack);
+        if ( node == NULL)
+        {
+            break;
+        }
+        context->busy++;
+        g_mutex_unlock (&context->lock);
+
+        tree_directory (context, node, dirent);
+
+        g_mutex_lock (&context->lock);
+        context->busy--;
+        if ( context->busy == 0 && g_queue_is_empty (&context->stack))
+        {
+            g_cond_broadcast (&context->cond);
+        }
+    }
+    g_mutex_unlock (&context->lock);
+
+    free (dirent);
+    return NULL;
+}
+
+// path 가 root 자신이거나 root 아래에 있으면 true 를 반환한다. 아직 없는 path 는 부모 directory 부터 확인한다.
+static bool tree_inside (String path, struct stat * root)
+{
+    struct stat statbuf;
+    struct stat upbuf;
+
+    if ( stat (path, &statbuf) == 0 && statbuf.st_dev == root->st_dev && statbuf.st_ino == root->st_ino )
+    {
+        return true;
+    }
+
+    String dir = parent_dir (path);
+    if ( dir == NULL)
+    {
+        return false;
+    }
+    int fd = open (dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    free (dir);
+
+    // ".." 을 따라 올라가며 / 에 닿을 때까지 root 를 찾는다.
+    while (fd != -1 && fstat (fd, &statbuf) == 0)
+    {
+        if ( statbuf.st_dev == root->st_dev && statbuf.st_ino == root->st_ino )
+        {
+            close (fd);
+            return true;
+        }
+
+        int up = openat (fd, "..", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+        close (fd);
+        if ( up == -1 || fstat (up, &upbuf) == -1 || (upbuf.st_dev == statbuf.st_dev && upbuf.st_ino == statbuf.st_ino))
+        {
+            if ( up != -1 )
+            {
+                close (up);
+            }
+            return false;
+        }
+        fd = up;
+    }
+
+    if ( fd != -1 )
+    {
+        close (fd);
+    }
+    return false;
+}
+
+// src 아래를 worker 들로 처리한다. 열린 fd 는 worker 당 최대 4 개 (원본 / 대상 directory, 원본 / 대상 파일) 이다.
+static bool tree_run (TreeOperation operation, String src, String dst, unsigned int flags, int threadCount)
+{
+    TreeContext context;
+    struct stat statbuf;
+
+    memset (&context, 0, sizeof (TreeContext));
+    context.operation = operation;
+    context.flags     = flags;
+    context.srcRoot   = src;
+    context.dstRoot   = dst;
+    context.dstfd     = -1;
+
+    if ( lstat (src, &statbuf) == -1 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "source file doesn't exist");
+        return false;
+    }
+
+    // directory 가 아니면 항목 하나만 처리한다.
+    if ( S_ISDIR (statbuf.st_mode) == false )
+    {
+        bool ret = (operation == TREE_COPY) ? tree_copy_entry (&context, AT_FDCWD, src, AT_FDCWD, dst) : unlink (src) == 0;
+        if ( ret == false )
+        {
+            dlog_print (DLOG_INFO, "DIT", "tree operation failed : %s : %s", src, strerror (errno));
+        }
+        return ret;
+    }
+
+    // 복사한 directory 를 다시 복사하며 끝없이 내려가지 않도록 src 아래로는 복사하지 않는다.
+    if ( operation == TREE_COPY && tree_inside (dst, &statbuf))
+    {
+        dlog_print (DLOG_INFO, "DIT", "dst is inside src : %s", dst);
+        errno = EINVAL;
+        return false;
+    }
+
+    context.srcfd = open (src, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if ( context.srcfd == -1 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "can not open source directory : %s", src);
+        return false;
+    }
+
+    if ( operation == TREE_COPY )
+    {
+        if ((mkdir (dst, S_IRWXU) == -1 && errno != EEXIST) || (context.dstfd = open (dst, O_RDONLY | O_DIRECTORY | O_CLOEXEC)) == -1 )
+        {
+            dlog_print (DLOG_INFO, "DIT", "can not open destination directory : %s", dst);
+            close (context.srcfd);
+            return false;
+        }
+    }
+
+    if ( threadCount <= 0 )
+    {
+        threadCount = g_get_num_processors ();
+    }
+
+    g_mutex_init (&context.lock);
+    g_cond_init (&context.cond);
+    g_queue_init (&context.stack);
+    g_queue_push_tail (&context.stack, tree_node_new (NULL, strdup ("."), &statbuf));
+
+    GThread ** threads = (GThread **)calloc (threadCount, sizeof (GThread *));
+
+    for (int i = 1; i < threadCount; i++)
+    {
+        threads[i] = g_thread_try_new ("FileTree", tree_worker_run, &context, NULL);
+    }
+    tree_worker_run (&context);
+
+    for (int i = 1; i < threadCount; i++)
+    {
+        if ( threads[i] != NULL)
+        {
+            g_thread_join (threads[i]);
+        }
+    }
+    free (threads);
+
+    g_cond_clear (&context.cond);
+    g_mutex_clear (&context.lock);
+    close (context.srcfd);
+    if ( context.dstfd != -1 )
+    {
+        close (context.dstfd);
+    }
+
+    return context.failed == 0;
+}
+
+bool copyTree (String src, String dst, int threadCount)
+{
+    if ( src == NULL || dst == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "src path / dst path not valid");
+        return false;
+    }
+    return tree_run (TREE_COPY, src, dst, 0, threadCount);
+}
+
+bool deleteTree (String src, int threadCount)
+{
+    if ( src == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "src path not valid");
+        return false;
+    }
+    return tree_run (TREE_DELETE, src, NULL, 0, threadCount);
+}
+
+bool moveTree (String src, String dst, int threadCount)
+{
+    if ( src == NULL || dst == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "src path / dst path not valid");
+        return false;
+    }
+
+    if ( rename (src, dst) == 0 )
+    {
+        sync_parent_dir (dst);
+        sync_parent_dir (src);
+        return true;
+    }
+
+    if ( errno != EXDEV )
+    {
+        dlog_print (DLOG_INFO, "DIT", "rename failed : %s", strerror (errno));
+        return false;
+    }
+
+    // 다른 파일 시스템이면 속성을 유지하여 복사하고 디스크에 기록된 후에 원본을 지운다.
+    bool created = (access (dst, F_OK) == -1);
+
+    if ( tree_run (TREE_COPY, src, dst, COPY_FLAG_PRESERVE | COPY_FLAG_SYNC, threadCount) == false )
+    {
+        if ( created )
+        {
+            tree_run (TREE_DELETE, dst, NULL, 0, threadCount);
+        }
+        return false;
+    }
+    sync_parent_dir (dst);
+
+    bool ret = tree_run (TREE_DELETE, src, NULL, 0, threadCount);
+    sync_parent_dir (src);
+    return ret;
+}
+
+// duplicate : 크기 -> 앞 4 KB hash -> 전체 hash 순으로 후보를 줄여서 읽는 양을 최소로 한다.
+typedef struct _DuplicateEntry DuplicateEntry;
+struct _DuplicateEntry
+{
+    String           path;   // root 기준 상대 경로
+    off_t            size;
+    dev_t            dev;
+    ino_t            ino;
+    uint64_t         prefix; // 앞 DUPLICATE_PREFIX_SIZE byte 의 hash
+    uint64_t         full;   // 전체 hash, 계산하지 않았으면 0
+    DuplicateEntry * leader; // 같은 inode (hard link) 중 대표, 대표만 읽는다.
+    bool             valid;
+};
+
+typedef enum
+{
+    DUPLICATE_STAT,
+    DUPLICATE_PREFIX,
+    DUPLICATE_FULL
+
+} DuplicateStage;
+
+typedef struct _DuplicateContext
+{
+    int               rootfd;
+    DuplicateStage    stage;
+    DuplicateEntry ** jobs;
+    int               count;
+    volatile gint     next;
+
+} DuplicateContext;
+
+static bool duplicate_hash (int rootfd, DuplicateEntry * entry, off_t limit, char * buffer, uint64_t * hash)
+{
+    ChecksumState state;
+    ssize_t       n;
+    off_t         total = 0;
+
+    int fd = openat (rootfd, entry->path, O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+    if ( fd == -1 )
+    {
+        return false;
+    }
+    if ( limit > DUPLICATE_PREFIX_SIZE )
+    {
+        posix_fadvise (fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+
+    checksum_init (&state, CHECKSUM_XXHASH64);
+    while (total < limit && (n = read (fd, buffer, MIN (limit - total, DUPLICATE_BUFFER_SIZE))) != 0)
+    {
+        if ( n == -1 )
+        {
+            if ( errno == EINTR )
+            {
+                continue;
+            }
+            close (fd);
+            return false;
+        }
+        checksum_update (&state, buffer, n);
+        total += n;
+    }
+    close (fd);
+
+    // 탐색 후 크기가 바뀐 파일은 비교하지 않는다.
+    if ( total != limit )
+    {
+        return false;
+    }
+    *hash = checksum_final (&state);
+    return true;
+}
+
+static gpointer duplicate_worker_run (gpointer data)
+{
+    DuplicateContext * context = (DuplicateContext *)data;
+    char             * buffer  = (context->stage == DUPLICATE_STAT) ? NULL : (char *)malloc (DUPLICATE_BUFFER_SIZE);
+    struct stat        statbuf;
+    int                index;
+
+    while ((index = g_atomic_int_add (&context->next, 1)) < context->count)
+    {
+        DuplicateEntry * entry = context->jobs[index];
+
+        switch (context->stage)
+        {
+        case DUPLICATE_STAT:
+            entry->valid = fstatat (context->rootfd, entry->path, &statbuf, AT_SYMLINK_NOFOLLOW) == 0
+                           && S_ISREG (statbuf.st_mode) && statbuf.st_size > 0;
+            if ( entry->valid )
+            {
+                entry->size = statbuf.st_size;
+                entry->dev  = statbuf.st_dev;
+                entry->ino  = statbuf.st_ino;
+            }
+            break;
+
+        case DUPLICATE_PREFIX:
+            entry->valid = duplicate_hash (context->rootfd, entry, MIN (entry->size, DUPLICATE_PREFIX_SIZE), buffer, &entry->prefix);
+            break;
+
+        case DUPLICATE_FULL:
+            entry->valid = duplicate_hash (context->rootfd, entry, entry->size, buffer, &entry->full);
+            break;
+        }
+    }
+
+    free (buffer);
+    return NULL;
+}
+
+static void duplicate_run_stage (DuplicateContext * context, DuplicateStage stage, DuplicateEntry ** jobs, int count, int threadCount)
+{
+    context->stage = stage;
+    context->jobs  = jobs;
+    context->count = count;
+    context->next  = 0;
+
+    if ( threadCount > count )
+    {
+        threadCount = count;
+    }
+
+    GThread ** threads = (GThread **)calloc (threadCount + 1, sizeof (GThread *));
+
+    for (int i = 1; i < threadCount; i++)
+    {
+        threads[i] = g_thread_try_new ("FileDuplicate", duplicate_worker_run, context, NULL);
+    }
+    duplicate_worker_run (context);
+
+    for (int i = 1; i < threadCount; i++)
+    {
+        if ( threads[i] != NULL)
+        {
+            g_thread_join (threads[i]);
+        }
+    }
+    free (threads);
+}
+
+// 크기 / hash / inode 순 정렬, 같은 inode 는 붙어 있게 된다.
+static int compare_duplicate_entry (const void * a, const void * b)
+{
+    const DuplicateEntry * left  = *(const DuplicateEntry **)a;
+    const DuplicateEntry * right = *(const DuplicateEntry **)b;
+
+    if ( left->size != right->size )
+    {
+        return (left->size < right->size) ? 1 : -1;
+    }
+    if ( left->prefix != right->prefix )
+    {
+        return (left->prefix < right->prefix) ? -1 : 1;
+    }
+    if ( left->full != right->full )
+    {
+        return (left->full < right->full) ? -1 : 1;
+    }
+    if ( left->dev != right->dev )
+    {
+        return (left->dev < right->dev) ? -1 : 1;
+    }
+    if ( left->ino != right->ino )
+    {
+        return (left->ino < right->ino) ? -1 : 1;
+    }
+    return strcmp (left->path, right->path);
+}
+
+static bool duplicate_same (DuplicateEntry * left, DuplicateEntry * right)
+{
+    return left->size == right->size && left->prefix == right->prefix && left->full == right->full;
+}
+
+// 유효한 entry 만 남기고 정렬한 후, 같은 후보 group 안에서 inode 가 둘 이상인 group 의 대표를 jobs 로 모은다.
+static int duplicate_select (DuplicateEntry ** entries, int * count, DuplicateEntry ** jobs, off_t minSize)
+{
+    int n = 0;
+    int jobCount = 0;
+
+    for (int i = 0; i < *count; i++)
+    {
+        if ( entries[i]->valid )
+        {
+            entries[n++] = entries[i];
+        }
+        else
+        {
+            free (entries[i]->path);
+            free (entries[i]);
+        }
+    }
+    *count = n;
+    qsort (entries, n, sizeof (DuplicateEntry *), compare_duplicate_entry);
+
+    for (int start = 0, end; start < n; start = end)
+    {
+        int inodes = 1;
+
+        entries[start]->leader = entries[start];
+        for (end = start + 1; end < n && duplicate_same (entries[start], entries[end]); end++)
+        {
+            bool link = entries[end]->dev == entries[end - 1]->dev && entries[end]->ino == entries[end - 1]->ino;
+
+            entries[end]->leader = link ? entries[end - 1]->leader : entries[end];
+            inodes += link ? 0 : 1;
+        }
+
+        if ( inodes > 1 && entries[start]->size > minSize )
+        {
+            for (int i = start; i < end; i++)
+            {
+                if ( entries[i]->leader == entries[i] )
+                {
+                    jobs[jobCount++] = entries[i];
+                }
+            }
+        }
+    }
+    return jobCount;
+}
+
+// 대표가 읽은 결과를 같은 inode 의 다른 entry 에 복사한다.
+static void duplicate_share (DuplicateEntry ** entries, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        DuplicateEntry * leader = entries[i]->leader;
+
+        if ( leader != entries[i] )
+        {
+            entries[i]->prefix = leader->prefix;
+            entries[i]->full   = leader->full;
+            entries[i]->valid  = leader->valid;
+        }
+    }
+}
+
+GList * findDuplicateFiles (String src, int threadCount)
+{
+    SearchContext context;
+    GList       * groups = NULL;
+
+    if ( src == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "src path not valid");
+        return NULL;
+    }
+
+    String root = realpath (src, NULL);
+    if ( root == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "target source file doesn't exist");
+        return NULL;
+    }
+
+    memset (&context, 0, sizeof (SearchContext));
+    context.collect     = true;
+    context.workerCount = threadCount;
+    if ( search_run (root, &context) == false )
+    {
+        free (root);
+        return NULL;
+    }
+
+    DuplicateContext duplicate;
+
+    // 항목들을 만들기 전에 확인해야 실패했을 때 정리할 것이 검색 결과뿐이다.
+    duplicate.rootfd = open (root, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if ( duplicate.rootfd == -1 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "target source file doesn't exist");
+        g_list_free_full (context.result, deleteIndexEntry);
+        free (root);
+        return NULL;
+    }
+
+    if ( threadCount <= 0 )
+    {
+        threadCount = g_get_num_processors ();
+    }
+
+    int               count   = 0;
+    int               total   = g_list_length (context.result);
+    DuplicateEntry ** entries = (DuplicateEntry **)malloc ((total + 1) * sizeof (DuplicateEntry *));
+    DuplicateEntry ** jobs    = (DuplicateEntry **)malloc ((total + 1) * sizeof (DuplicateEntry *));
+
+    for (GList * iter = context.result; iter != NULL; iter = iter->next)
+    {
+        IndexEntry * item = (IndexEntry *)iter->data;
+
+        if ( item->type == DT_REG )
+        {
+            DuplicateEntry * entry = (DuplicateEntry *)calloc (1, sizeof (DuplicateEntry));
+
+            entry->path      = item->path;
+            item->path       = NULL;
+            entries[count++] = entry;
+        }
+    }
+    g_list_free_full (context.result, deleteIndexEntry);
+
+    // 1 단계 : 크기가 같은 다른 파일이 있는 파일만 앞부분을 읽는다.
+    duplicate_run_stage (&duplicate, DUPLICATE_STAT, entries, count, threadCount);
+    int jobCount = duplicate_select (entries, &count, jobs, 0);
+
+    duplicate_run_stage (&duplicate, DUPLICATE_PREFIX, jobs, jobCount, threadCount);
+    duplicate_share (entries, count);
+
+    // 2 단계 : 앞부분이 같고 4 KB 보다 큰 파일만 전체를 읽는다. 4 KB 이하는 앞부분 hash 가 전체 hash 이다.
+    jobCount = duplicate_select (entries, &count, jobs, DUPLICATE_PREFIX_SIZE);
+
+    duplicate_run_stage (&duplicate, DUPLICATE_FULL, jobs, jobCount, threadCount);
+    duplicate_share (entries, count);
+    duplicate_select (entries, &count, jobs, 0);
+
+    close (duplicate.rootfd);
+
+    // 크기가 큰 group 부터 반환한다.
+    for (int start = 0, end; start < count; start = end)
+    {
+        for (end = start + 1; end < count && duplicate_same (entries[start], entries[end]); end++)
+        {
+        }
+
+        if ( end - start > 1 )
+        {
+            GList * group = NULL;
+
+            for (int i = end - 1; i >= start; i--)
+            {
+                group = g_list_prepend (group, join_path (root, entries[i]->path));
+            }
+            groups = g_list_prepend (groups, g_list_sort (group, (GCompareFunc)strcmp));
+        }
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        free (entries[i]->path);
+        free (entries[i]);
+    }
+    free (entries);
+    free (jobs);
+    free (root);
+
+    return g_list_reverse (groups);
+}
+
+void deleteDuplicateList (GList * groups)
+{
+    for (GList * iter = groups; iter != NULL; iter = iter->next)
+    {
+        g_list_free_full ((GList *)iter->data, free);
+    }
+    g_list_free (groups);
+}
+
+// disk usage : directory 마다 직접 포함한 항목의 사용량을 snapshot 으로 기록하고, 질의할 때 하위 directory 까지 합산한다.
+typedef struct _UsageInode
+{
+    dev_t     dev;
+    ino_t     ino;
+    long long size;
+    long long allocated;
+
+} UsageInode;
+
+typedef struct _UsageDir
+{
+    dev_t        dev;
+    ino_t        ino;
+    int64_t      mtime;      // 다시 읽어야 하면 -1
+    long long    size;       // hard link 가 아닌 직접 포함한 파일들
+    long long    allocated;  // 위 파일들 + directory 자신
+    long long    files;
+    UsageInode * links;      // link 수가 2 이상인 파일, 합산할 때 inode 로 중복을 제거한다.
+    int          linkCount;
+    String     * children;   // 하위 directory 이름
+    int          childCount;
+
+} UsageDir;
+
+typedef struct _UsageTask
+{
+    String      path;        // root 기준 상대 경로
+    struct stat statbuf;
+
+} UsageTask;
+
+typedef struct _UsageContext
+{
+    int            rootfd;
+    GHashTable   * previous; // 이전 snapshot, update 중에는 읽기만 한다.
+    GHashTable   * dirs;     // 새 snapshot
+    int64_t        racy;     // 이 시각 이후에 바뀐 directory 는 mtime 을 믿지 않는다.
+    GMutex         lock;
+    GCond          cond;
+    GQueue         stack;    // UsageTask *
+    int            busy;
+    volatile gint  failed;
+    volatile gint  rescanned;
+
+} UsageContext;
+
+// 배열 크기가 0, 4, 8, 16 ... 이 될 때마다 두배로 늘린다.
+static void usage_append (void ** array, int * count, size_t size, const void * item)
+{
+    if ( *count == 0 || (*count >= 4 && (*count & (*count - 1)) == 0))
+    {
+        *array = realloc (*array, size * (*count == 0 ? 4 : *count * 2));
+    }
+    memcpy ((char *)*array + size * (*count), item, size);
+    (*count)++;
+}
+
+static void usage_dir_free (gpointer data)
+{
+    UsageDir * dir = (UsageDir *)data;
+
+    for (int i = 0; i < dir->childCount; i++)
+    {
+        free (dir->children[i]);
+    }
+    free (dir->children);
+    free (dir->links);
+    free (dir);
+}
+
+static guint usage_inode_hash (gconstpointer key)
+{
+    const UsageInode * inode = (const UsageInode *)key;
+    uint64_t           value = (uint64_t)inode->ino ^ ((uint64_t)inode->dev << 32);
+
+    return (guint)(value ^ (value >> 32));
+}
+
+static gboolean usage_inode_equal (gconstpointer a, gconstpointer b)
+{
+    const UsageInode * left  = (const UsageInode *)a;
+    const UsageInode * right = (const UsageInode *)b;
+
+    return left->dev == right->dev && left->ino == right->ino;
+}
+
+static void usage_push (UsageContext * context, String path, struct stat * statbuf)
+{
+    UsageTask * task = (UsageTask *)malloc (sizeof (UsageTask));
+
+    task->path    = path;
+    task->statbuf = *statbuf;
+
+    g_mutex_lock (&context->lock);
+    g_queue_push_tail (&context->stack, task);
+    g_cond_signal (&context->cond);
+    g_mutex_unlock (&context->lock);
+}
+
+// 이전 snapshot 과 mtime 이 같으면 내용을 읽지 않고 하위 directory 만 다시 확인한다.
+static UsageDir * usage_reuse (UsageContext * context, UsageTask * task)
+{
+    struct stat statbuf;
+
+    if ( context->previous == NULL)
+    {
+        return NULL;
+    }
+
+    UsageDir * dir = (UsageDir *)g_hash_table_lookup (context->previous, task->path);
+    if ( dir == NULL || dir->mtime != stat_mtime (&task->statbuf) || dir->ino != task->statbuf.st_ino || dir->dev != task->statbuf.st_dev )
+    {
+        return NULL;
+    }
+
+    for (int i = 0; i < dir->childCount; i++)
+    {
+        String path = join_path (task->path, dir->children[i]);
+
+        if ( fstatat (context->rootfd, path, &statbuf, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR (statbuf.st_mode))
+        {
+            usage_push (context, path, &statbuf);
+        }
+        else
+        {
+            free (path);
+        }
+    }
+    return dir;
+}
+
+static UsageDir * usage_scan (UsageContext * context, UsageTask * task, char * dirent)
+{
+    UsageDir  * dir = (UsageDir *)calloc (1, sizeof (UsageDir));
+    struct stat statbuf;
+    long        nread;
+
+    dir->dev       = task->statbuf.st_dev;
+    dir->ino       = task->statbuf.st_ino;
+    dir->mtime     = stat_mtime (&task->statbuf);
+    dir->allocated = (long long)task->statbuf.st_blocks * 512;
+
+    // 읽는 도중에 바뀌었을 수 있으므로 다음 update 에서 다시 읽는다.
+    if ( dir->mtime >= context->racy )
+    {
+        dir->mtime = -1;
+    }
+    g_atomic_int_inc (&context->rescanned);
+
+    int fd = openat (context->rootfd, task->path, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if ( fd == -1 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "can not read directory : %s : %s", task->path, strerror (errno));
+        g_atomic_int_set (&context->failed, 1);
+        dir->mtime = -1;
+        return dir;
+    }
+
+    while ((nread = syscall (SYS_getdents64, fd, dirent, SEARCH_DIRENT_SIZE)) > 0)
+    {
+        for (long pos = 0; pos < nread;)
+        {
+            struct linux_dirent64 * entry = (struct linux_dirent64 *)(dirent + pos);
+
+            pos += entry->d_reclen;
+
+            if ( strcmp (".", entry->d_name) == 0 || strcmp ("..", entry->d_name) == 0 )
+            {
+                continue;
+            }
+
+            // 읽는 사이에 삭제된 항목은 건너뛴다.
+            if ( fstatat (fd, entry->d_name, &statbuf, AT_SYMLINK_NOFOLLOW) == -1 )
+            {
+                continue;
+            }
+
+            if ( S_ISDIR (statbuf.st_mode))
+            {
+                String name = strdup (entry->d_name);
+
+                usage_append ((void **)&dir->children, &dir->childCount, sizeof (String), &name);
+                usage_push (context, join_path (task->path, entry->d_name), &statbuf);
+            }
+            else if ( statbuf.st_nlink > 1 )
+            {
+                UsageInode inode = {statbuf.st_dev, statbuf.st_ino, statbuf.st_size, (long long)statbuf.st_blocks * 512};
+
+                usage_append ((void **)&dir->links, &dir->linkCount, sizeof (UsageInode), &inode);
+            }
+            else
+            {
+                dir->size      += statbuf.st_size;
+                dir->allocated += (long long)statbuf.st_blocks * 512;
+                dir->files++;
+            }
+        }
+    }
+    close (fd);
+    return dir;
+}
+
+static gpointer usage_worker_run (gpointer data)
+{
+    UsageContext * context = (UsageContext *)data;
+    char         * dirent  = NULL;
+
+    g_mutex_lock (&context->lock);
+    while (true)
+    {
+        while (g_queue_is_empty (&context->stack) && context->busy > 0)
+        {
+            g_cond_wait (&context->cond, &context->lock);
+        }
+
+        UsageTask * task = (UsageTask *)g_queue_pop_tail (&context->stack);
+        if ( task == NULL)
+        {
+            break;
+        }
+        context->busy++;
+        g_mutex_unlock (&context->lock);
+
+        UsageDir * dir = usage_reuse (context, task);
+        if ( dir == NULL)
+        {
+            if ( dirent == NULL)
+            {
+                dirent = (char *)malloc (SEARCH_DIRENT_SIZE);
+            }
+            dir = usage_scan (context, task, dirent);
+        }
+
+        g_mutex_lock (&context->lock);
+        g_hash_table_insert (context->dirs, task->path, dir);
+        free (task);
+
+        context->busy--;
+        if ( context->busy == 0 && g_queue_is_empty (&context->stack))
+        {
+            g_cond_broadcast (&context->cond);
+        }
+    }
+    g_mutex_unlock (&context->lock);
+
+    free (dirent);
+    return NULL;
+}
+
+// 이전 snapshot 을 해제한다. 새 snapshot 이 같은 경로에 다시 사용한 directory 는 꺼내서 해제하지 않는다.
+static void usage_release (GHashTable * previous, GHashTable * dirs)
+{
+    GHashTableIter iter;
+    gpointer       key;
+    gpointer       value;
+
+    g_hash_table_iter_init (&iter, previous);
+    while (g_hash_table_iter_next (&iter, &key, &value))
+    {
+        if ( g_hash_table_lookup (dirs, key) == value )
+        {
+            g_hash_table_iter_steal (&iter);
+            free (key);
+        }
+    }
+    g_hash_table_destroy (previous);
+}
+
+// 새 snapshot 을 만든다. 이전 snapshot 이 있으면 mtime 이 바뀐 directory 만 다시 읽는다.
+static GHashTable * usage_run (DiskUsageExtends * this, GHashTable * previous)
+{
+    UsageContext context;
+    struct stat  statbuf;
+
+    memset (&context, 0, sizeof (UsageContext));
+
+    context.rootfd = open (this->root, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if ( context.rootfd == -1 || fstat (context.rootfd, &statbuf) == -1 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "can not open directory : %s", this->root);
+        if ( context.rootfd != -1 )
+        {
+            close (context.rootfd);
+        }
+        return NULL;
+    }
+
+    context.previous = previous;
+    context.dirs     = g_hash_table_new_full (g_str_hash, g_str_equal, free, usage_dir_free);
+    context.racy     = (g_get_real_time () / 1000000 - USAGE_RACY_WINDOW) * 1000000000LL;
+
+    g_mutex_init (&context.lock);
+    g_cond_init (&context.cond);
+    g_queue_init (&context.stack);
+
+    UsageTask * task = (UsageTask *)malloc (sizeof (UsageTask));
+    task->path    = strdup (".");
+    task->statbuf = statbuf;
+    g_queue_push_tail (&context.stack, task);
+
+    GThread ** threads = (GThread **)calloc (this->threadCount, sizeof (GThread *));
+
+    for (int i = 1; i < this->threadCount; i++)
+    {
+        threads[i] = g_thread_try_new ("FileUsage", usage_worker_run, &context, NULL);
+    }
+    usage_worker_run (&context);
+
+    for (int i = 1; i < this->threadCount; i++)
+    {
+        if ( threads[i] != NULL)
+        {
+            g_thread_join (threads[i]);
+        }
+    }
+    free (threads);
+
+    g_cond_clear (&context.cond);
+    g_mutex_clear (&context.lock);
+    close (context.rootfd);
+
+    dlog_print (DLOG_INFO, "DIT", "disk usage : %d of %d directories scanned", context.rescanned, g_hash_table_size (context.dirs));
+    this->failed = (context.failed != 0);
+    return context.dirs;
+}
+
+DiskUsage NewDiskUsage (String src, int threadCount)
+{
+    if ( src == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "src path not valid");
+        return NULL;
+    }
+
+    DiskUsageExtends * this = (DiskUsageExtends *)malloc (sizeof (DiskUsageExtends));
+
+    this->usage.Update  = updateDiskUsage;
+    this->usage.getInfo = getDiskUsageInfo;
+
+    this->root        = realpath (src, NULL);
+    this->threadCount = (threadCount > 0) ? threadCount : (int)g_get_num_processors ();
+    this->failed      = false;
+    this->updating    = false;
+    this->dirs        = NULL;
+    g_mutex_init (&this->lock);
+
+    if ( this->root == NULL || (this->dirs = usage_run (this, NULL)) == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "target source file doesn't exist");
+        g_mutex_clear (&this->lock);
+        free (this->root);
+        free (this);
+        return NULL;
+    }
+
+    return &this->usage;
+}
+
+void DestroyDiskUsage (DiskUsage this_gen)
+{
+    if ( this_gen != NULL)
+    {
+        DiskUsageExtends * this = (DiskUsageExtends *)this_gen;
+
+        g_hash_table_destroy (this->dirs);
+        g_mutex_clear (&this->lock);
+        free (this->root);
+        free (this);
+    }
+}
+
+bool updateDiskUsage (DiskUsage this_gen)
+{
+    if ( this_gen == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "DiskUsage not valid");
+        return false;
+    }
+
+    DiskUsageExtends * this = (DiskUsageExtends *)this_gen;
+
+    g_mutex_lock (&this->lock);
+    if ( this->updating )
+    {
+        g_mutex_unlock (&this->lock);
+        dlog_print (DLOG_INFO, "DIT", "DiskUsage update already running");
+        return false;
+    }
+    this->updating = true;
+    GHashTable * previous = this->dirs;
+    g_mutex_unlock (&this->lock);
+
+    // update 중의 질의는 이전 snapshot 으로 응답하고, 교체는 lock 안에서 한번에 한다.
+    GHashTable * dirs = usage_run (this, previous);
+
+    if ( dirs != NULL)
+    {
+        g_mutex_lock (&this->lock);
+        this->dirs = dirs;
+        g_mutex_unlock (&this->lock);
+
+        // 다음 update 가 dirs 를 이전 snapshot 으로 쓰기 전에 해제를 끝내야 한다.
+        usage_release (previous, dirs);
+    }
+
+    g_mutex_lock (&this->lock);
+    this->updating = false;
+    g_mutex_unlock (&this->lock);
+
+    return dirs != NULL && this->failed == false;
+}
+
+bool getDiskUsageInfo (DiskUsage this_gen, String path, DiskUsageInfo * info)
+{
+    if ( this_gen == NULL || info == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "DiskUsage / info not valid");
+        return false;
+    }
+
+    DiskUsageExtends * this    = (DiskUsageExtends *)this_gen;
+    size_t             rootlen = strlen (this->root);
+    String             relpath = ".";
+
+    // 절대 경로는 root 기준 상대 경로로 바꾼다.
+    if ( path != NULL && strncmp (path, this->root, rootlen) == 0 && (path[rootlen] == '/' || path[rootlen] == '\0'))
+    {
+        path += rootlen;
+        while (*path == '/')
+        {
+            path++;
+        }
+    }
+    if ( path != NULL && *path != '\0' )
+    {
+        relpath = path;
+    }
+
+    String start = strdup (relpath);
+    size_t len   = strlen (start);
+
+    while (len > 1 && start[len - 1] == '/')
+    {
+        start[--len] = '\0';
+    }
+
+    GHashTable * inodes = g_hash_table_new (usage_inode_hash, usage_inode_equal);
+    GQueue       pending;
+    bool         found = false;
+
+    memset (info, 0, sizeof (DiskUsageInfo));
+
+    // path 에서 시작하여 각 directory 의 하위 directory 이름으로 따라 내려가므로 subtree 만 확인한다.
+    g_queue_init (&pending);
+    g_queue_push_tail (&pending, start);
+
+    g_mutex_lock (&this->lock);
+    for (String name; (name = (String)g_queue_pop_head (&pending)) != NULL; free (name))
+    {
+        UsageDir * dir = (UsageDir *)g_hash_table_lookup (this->dirs, name);
+        if ( dir == NULL)
+        {
+            continue;
+        }
+
+        found = true;
+        info->size      += dir->size;
+        info->allocated += dir->allocated;
+        info->files     += dir->files;
+        info->directories++;
+
+        for (int i = 0; i < dir->linkCount; i++)
+        {
+            if ( g_hash_table_contains (inodes, &dir->links[i]) == false )
+            {
+                g_hash_table_add (inodes, &dir->links[i]);
+                info->size      += dir->links[i].size;
+                info->allocated += dir->links[i].allocated;
+                info->files++;
+            }
+        }
+
+        for (int i = 0; i < dir->childCount; i++)
+        {
+            g_queue_push_tail (&pending, join_path (name, dir->children[i]));
+        }
+    }
+    g_mutex_unlock (&this->lock);
+
+    g_hash_table_destroy (inodes);
+
+    if ( found == false )
+    {
+        dlog_print (DLOG_INFO, "DIT", "directory not in snapshot : %s", relpath);
+        memset (info, 0, sizeof (DiskUsageInfo));
+    }
+    return found;
+}
+
+bool getDiskUsage (String src, int threadCount, DiskUsageInfo * info)
+{
+    if ( info == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "info not valid");
+        return false;
+    }
+
+    DiskUsage usage = NewDiskUsage (src, threadCount);
+    if ( usage == NULL)
+    {
+        return false;
+    }
+
+    DiskUsageExtends * this = (DiskUsageExtends *)usage;
+    bool               ret  = getDiskUsageInfo (usage, NULL, info) && this->failed == false;
+
+    DestroyDiskUsage (usage);
+    return ret;
+}
+
+// file index : 이름 순으로 정렬된 table 을 mmap 하고 inotify 로 받은 변경 사항을 overlay 로 반영한다.
+typedef struct _IndexHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t count;
+    uint64_t strings; // string blob 의 file offset
+    int64_t  mtime;   // root directory 의 mtime (ns)
+
+} IndexHeader;
+
+typedef struct _IndexRecord
+{
+    uint32_t name;    // string blob offset
+    uint32_t path;    // string blob offset (root 기준 상대 경로)
+    uint32_t type;
+    uint32_t reserved;
+    int64_t  mtime;   // directory 의 mtime (ns)
+
+} IndexRecord;
+
+static GMutex  fileIndexLock;
+static GList * fileIndexList = NULL;
+
+static IndexRecord * fileindex_records (FileIndexExtends * this)
+{
+    return (IndexRecord *)((char *)this->map + sizeof (IndexHeader));
+}
+
+static const char * fileindex_string (FileIndexExtends * this, uint32_t offset)
+{
+    IndexHeader * header = (IndexHeader *)this->map;
+
+    return (const char *)this->map + header->strings + offset;
+}
+
+static void fileindex_unmap (FileIndexExtends * this)
+{
+    if ( this->map != NULL)
+    {
+        munmap (this->map, this->mapSize);
+        this->map     = NULL;
+        this->mapSize = 0;
+    }
+}
+
+// 잘리거나 손상된 index 파일로 mmap 밖을 읽지 않도록 header, root 와 모든 record 의 offset 을 확인한다.
+static bool fileindex_valid (const char * map, size_t size, String root)
+{
+    const IndexHeader * header = (const IndexHeader *)map;
+
+    if ( memcmp (header->magic, FILE_INDEX_MAGIC, sizeof (header->magic)) != 0 || header->version != FILE_INDEX_VERSION
+         || header->strings != sizeof (IndexHeader) + (uint64_t)header->count * sizeof (IndexRecord)
+         || header->strings >= (uint64_t)size )
+    {
+        return false;
+    }
+
+    // string blob 이 NUL 로 끝나면 blob 안의 offset 에서 시작하는 문자열은 모두 map 안에서 끝난다.
+    const char * strings = map + header->strings;
+    size_t       length  = size - header->strings;
+    const char * end     = (const char *)memchr (strings, '\0', length);
+
+    if ( map[size - 1] != '\0' || end == NULL || strcmp (strings, root) != 0 )
+    {
+        return false;
+    }
+
+    const IndexRecord * records = (const IndexRecord *)(map + sizeof (IndexHeader));
+
+    for (uint32_t i = 0; i < header->count; i++)
+    {
+        if ( records[i].path <= (size_t)(end - strings) || records[i].path >= length
+             || records[i].name < records[i].path || records[i].name >= length )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// index 파일을 mmap 하여 map / mapSize 에 기록한다. this 의 root / path 만 읽으므로 lock 없이 호출할 수 있다.
+static bool fileindex_open (FileIndexExtends * this, void ** mapped, size_t * mapSize)
+{
+    struct stat statbuf;
+
+    int fd = open (this->path, O_RDONLY | O_CLOEXEC);
+    if ( fd == -1 )
+    {
+        return false;
+    }
+
+    if ( fstat (fd, &statbuf) == -1 || statbuf.st_size < (off_t)sizeof (IndexHeader))
+    {
+        close (fd);
+        return false;
+    }
+
+    void * map = mmap (NULL, statbuf.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close (fd);
+    if ( map == MAP_FAILED )
+    {
+        return false;
+    }
+
+    if ( fileindex_valid ((const char *)map, statbuf.st_size, this->root) == false )
+    {
+        dlog_print (DLOG_INFO, "DIT", "file index not valid : %s", this->path);
+        munmap (map, statbuf.st_size);
+        return false;
+    }
+
+    *mapped  = map;
+    *mapSize = statbuf.st_size;
+    return true;
+}
+
+static bool fileindex_map (FileIndexExtends * this)
+{
+    void * map;
+    size_t size;
+
+    if ( fileindex_open (this, &map, &size) == false )
+    {
+        return false;
+    }
+
+    fileindex_unmap (this);
+    this->map     = map;
+    this->mapSize = size;
+    return true;
+}
+
+static bool fileindex_add_watch (FileIndexExtends * this, const char * relpath, int64_t * mtime)
+{
+    String      full = (strcmp (relpath, ".") == 0) ? strdup (this->root) : join_path (this->root, (String)relpath);
+    struct stat statbuf;
+
+    int wd = inotify_add_watch (this->inotify, full, FILE_INDEX_MASK);
+    if ( wd == -1 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "can not watch %s : %s", full, strerror (errno));
+        free (full);
+        return false;
+    }
+    g_hash_table_replace (this->watches, GINT_TO_POINTER (wd), strdup (relpath));
+
+    // watch 를 등록한 후 mtime 을 읽어야 그 사이의 변경을 놓치지 않는다.
+    if ( mtime != NULL)
+    {
+        *mtime = (lstat (full, &statbuf) == 0) ? stat_mtime (&statbuf) : -1;
+    }
+    free (full);
+    return true;
+}
+
+// 모든 directory 에 watch 를 등록하고 index 가 만들어진 이후 변경된 directory 가 있는지 확인한다.
+static void fileindex_watch (FileIndexExtends * this)
+{
+    IndexHeader * header  = (IndexHeader *)this->map;
+    IndexRecord * records = fileindex_records (this);
+    int64_t       mtime;
+
+    if ( this->inotify != -1 )
+    {
+        close (this->inotify);
+    }
+    g_hash_table_remove_all (this->watches);
+    g_hash_table_remove_all (this->added);
+    g_hash_table_remove_all (this->removed);
+    this->changes = 0;
+    this->stale   = false;
+    this->live    = false;
+
+    this->inotify = inotify_init1 (IN_NONBLOCK | IN_CLOEXEC);
+    if ( this->inotify == -1 || fileindex_add_watch (this, ".", &mtime) == false )
+    {
+        return;
+    }
+    this->stale = (mtime != header->mtime);
+
+    for (uint32_t i = 0; i < header->count; i++)
+    {
+        if ( records[i].type != DT_DIR )
+        {
+            continue;
+        }
+        if ( fileindex_add_watch (this, fileindex_string (this, records[i].path), &mtime) == false )
+        {
+            return;
+        }
+        this->stale |= (mtime != records[i].mtime);
+    }
+    this->live = true;
+}
+
+static int compare_index_entry (const void * a, const void * b)
+{
+    const IndexEntry * left  = *(const IndexEntry **)a;
+    const IndexEntry * right = *(const IndexEntry **)b;
+
+    int ret = strcmp (left->path + left->name, right->path + right->name);
+    return ret != 0 ? ret : strcmp (left->path, right->path);
+}
+
+static void deleteIndexEntry (gpointer data)
+{
+    IndexEntry * item = (IndexEntry *)data;
+
+    free (item->path);
+    free (item);
+}
+
+static bool fileindex_write (FileIndexExtends * this, IndexEntry ** entries, uint32_t count, int64_t mtime)
+{
+    IndexHeader header;
+    IndexRecord record;
+    uint32_t    offset = strlen (this->root) + 1;
+
+    String tmp  = g_strdup_printf ("%s.tmp", this->path);
+    FILE * out  = fopen (tmp, "wb");
+    bool   ret  = (out != NULL);
+
+    memset (&header, 0, sizeof (IndexHeader));
+    memcpy (header.magic, FILE_INDEX_MAGIC, sizeof (header.magic));
+    header.version = FILE_INDEX_VERSION;
+    header.count   = count;
+    header.strings = sizeof (IndexHeader) + (uint64_t)count * sizeof (IndexRecord);
+    header.mtime   = mtime;
+
+    ret = ret && fwrite (&header, sizeof (IndexHeader), 1, out) == 1;
+
+    for (uint32_t i = 0; ret && i < count; i++)
+    {
+        memset (&record, 0, sizeof (IndexRecord));
+        record.path  = offset;
+        record.name  = offset + entries[i]->name;
+        record.type  = entries[i]->type;
+        record.mtime = entries[i]->mtime;
+        offset += strlen (entries[i]->path) + 1;
+
+        ret = fwrite (&record, sizeof (IndexRecord), 1, out) == 1;
+    }
+
+    ret = ret && fwrite (this->root, strlen (this->root) + 1, 1, out) == 1;
+    for (uint32_t i = 0; ret && i < count; i++)
+    {
+        ret = fwrite (entries[i]->path, strlen (entries[i]->path) + 1, 1, out) == 1;
+    }
+
+    if ( out != NULL)
+    {
+        ret = ret && fflush (out) == 0 && fsync (fileno (out)) == 0;
+        ret = (fclose (out) == 0) && ret;
+    }
+
+    // 완성된 index 만 보이도록 임시 파일을 만든 후 rename 한다.
+    ret = ret && rename (tmp, this->path) == 0;
+    if ( ret )
+    {
+        sync_parent_dir (this->path);
+    }
+    else
+    {
+        remove (tmp);
+        dlog_print (DLOG_INFO, "DIT", "can not write file index : %s", this->path);
+    }
+    g_free (tmp);
+
+    return ret;
+}
+
+// 전체 tree 를 탐색하여 새 index 파일을 만들고 mmap 한다. 오래 걸리므로 lock 없이 호출한다.
+static bool fileindex_create (FileIndexExtends * this, void ** map, size_t * mapSize)
+{
+    SearchContext context;
+    struct stat   statbuf;
+
+    if ( lstat (this->root, &statbuf) == -1 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "target source file doesn't exist");
+        return false;
+    }
+
+    memset (&context, 0, sizeof (SearchContext));
+    context.collect = true;
+    if ( search_run (this->root, &context) == false )
+    {
+        return false;
+    }
+
+    uint32_t      count   = g_list_length (context.result);
+    IndexEntry ** entries = (IndexEntry **)malloc ((count + 1) * sizeof (IndexEntry *));
+    uint32_t      i       = 0;
+
+    for (GList * iter = context.result; iter != NULL; iter = iter->next)
+    {
+        entries[i++] = (IndexEntry *)iter->data;
+    }
+    qsort (entries, count, sizeof (IndexEntry *), compare_index_entry);
+
+    bool ret = fileindex_write (this, entries, count, stat_mtime (&statbuf)) && fileindex_open (this, map, mapSize);
+
+    g_list_free_full (context.result, deleteIndexEntry);
+    free (entries);
+
+    return ret;
+}
+
+// this->lock 을 잡은 상태로 호출한다. 만드는 동안에는 lock 을 놓아 검색을 막지 않고, 완성된 table 만 lock 안에서 교체한다.
+static bool fileindex_build (FileIndexExtends * this)
+{
+    void * map;
+    size_t size;
+
+    // 다른 thread 가 만들고 있으면 그 결과를 기다린다.
+    if ( this->building )
+    {
+        while (this->building)
+        {
+            g_cond_wait (&this->built, &this->lock);
+        }
+        return this->live;
+    }
+
+    this->building = true;
+    g_mutex_unlock (&this->lock);
+
+    bool ret = fileindex_create (this, &map, &size);
+
+    g_mutex_lock (&this->lock);
+    this->building = false;
+    g_cond_broadcast (&this->built);
+
+    if ( ret )
+    {
+        fileindex_unmap (this);
+        this->map     = map;
+        this->mapSize = size;
+        fileindex_watch (this);
+    }
+    return ret;
+}
+
+// 새로 생긴 directory 는 watch 를 등록한 후 내부를 탐색하여 overlay 에 추가한다.
+static void fileindex_add_tree (FileIndexExtends * this, String relpath)
+{
+    SearchContext context;
+
+    if ( fileindex_add_watch (this, relpath, NULL) == false )
+    {
+        this->live = false;
+        return;
+    }
+
+    memset (&context, 0, sizeof (SearchContext));
+    context.collect     = true;
+    context.workerCount = 1;
+
+    String full = join_path (this->root, relpath);
+    if ( search_run (full, &context))
+    {
+        for (GList * iter = context.result; iter != NULL; iter = iter->next)
+        {
+            IndexEntry * item = (IndexEntry *)iter->data;
+            String       path = join_path (relpath, item->path);
+
+            g_hash_table_remove (this->removed, path);
+            g_hash_table_replace (this->added, strdup (path), GINT_TO_POINTER (item->type));
+            if ( item->type == DT_DIR && fileindex_add_watch (this, path, NULL) == false )
+            {
+                this->live = false;
+            }
+            this->changes++;
+            free (path);
+        }
+        g_list_free_full (context.result, deleteIndexEntry);
+    }
+    free (full);
+}
+
+static void fileindex_apply (FileIndexExtends * this, struct inotify_event * event)
+{
+    struct stat statbuf;
+
+    if ( event->mask & IN_Q_OVERFLOW )
+    {
+        this->stale = true;
+        return;
+    }
+
+    if ( event->mask & IN_IGNORED )
+    {
+        g_hash_table_remove (this->watches, GINT_TO_POINTER (event->wd));
+        return;
+    }
+
+    // 감시중인 directory 자체가 이동되면 하위 경로들을 모두 다시 만들어야 한다.
+    String dir = (String)g_hash_table_lookup (this->watches, GINT_TO_POINTER (event->wd));
+    if ( dir == NULL || event->len == 0 || (event->mask & IN_MOVE_SELF))
+    {
+        this->stale |= (event->mask & IN_MOVE_SELF) != 0;
+        return;
+    }
+
+    String relpath = join_path (dir, event->name);
+
+    if ( event->mask & (IN_CREATE | IN_MOVED_TO))
+    {
+        unsigned char type = DT_DIR;
+
+        if ((event->mask & IN_ISDIR) == 0 )
+        {
+            String full = join_path (this->root, relpath);
+            type = (lstat (full, &statbuf) == 0) ? IFTODT(statbuf.st_mode) : DT_REG;
+            free (full);
+        }
+
+        g_hash_table_remove (this->removed, relpath);
+        g_hash_table_replace (this->added, strdup (relpath), GINT_TO_POINTER (type));
+        if ( type == DT_DIR )
+        {
+            fileindex_add_tree (this, relpath);
+        }
+    }
+    else if ( event->mask & (IN_DELETE | IN_MOVED_FROM))
+    {
+        if ((event->mask & IN_ISDIR) && (event->mask & IN_MOVED_FROM))
+        {
+            this->stale = true;
+        }
+        g_hash_table_remove (this->added, relpath);
+        g_hash_table_add (this->removed, strdup (relpath));
+    }
+
+    free (relpath);
+
+    if ( ++this->changes > FILE_INDEX_COMPACT )
+    {
+        this->stale = true;
+    }
+}
+
+static void fileindex_update (FileIndexExtends * this)
+{
+    alignas (struct inotify_event) char buff[FILE_INDEX_EVENT_SIZE];
+    ssize_t len;
+
+    if ( this->inotify == -1 )
+    {
+        return;
+    }
+
+    while ((len = read (this->inotify, buff, sizeof (buff))) > 0)
+    {
+        for (char * pos = buff; pos < buff + len;)
+        {
+            struct inotify_event * event = (struct inotify_event *)pos;
+
+            fileindex_apply (this, event);
+            pos += sizeof (struct inotify_event) + event->len;
+        }
+    }
+}
+
+static bool under_prefix (const char * path, const char * prefix, size_t prefixLen)
+{
+    return prefixLen == 0 || (strncmp (path, prefix, prefixLen) == 0 && path[prefixLen] == '/');
+}
+
+static void fileindex_result (FileIndexExtends * this, const char * relpath, unsigned char type, GList ** result)
+{
+    String pPath = join_path (this->root, (String)relpath);
+
+    if ( type == DT_LNK )
+    {
+        String resolved = realpath (pPath, NULL);
+        free (pPath);
+        pPath = resolved;
+    }
+
+    if ( pPath != NULL)
+    {
+        *result = g_list_prepend (*result, pPath);
+    }
+}
+
+// prefix 는 root 기준 상대 경로이며 빈 문자열이면 index 전체에서 찾는다.
+static bool fileindex_lookup (FileIndexExtends * this, const char * prefix, String name, GList ** result)
+{
+    fileindex_update (this);
+
+    if ( this->stale && this->live )
+    {
+        fileindex_build (this);
+    }
+
+    if ( this->live == false || this->map == NULL)
+    {
+        return false;
+    }
+
+    IndexHeader * header    = (IndexHeader *)this->map;
+    IndexRecord * records   = fileindex_records (this);
+    size_t        prefixLen = strlen (prefix);
+    GHashTable  * seen      = NULL;
+    uint32_t      low       = 0;
+    uint32_t      high      = header->count;
+
+    if ( g_hash_table_size (this->added) > 0 )
+    {
+        seen = g_hash_table_new (g_str_hash, g_str_equal);
+    }
+
+    while (low < high)
+    {
+        uint32_t mid = low + (high - low) / 2;
+
+        if ( strcmp (fileindex_string (this, records[mid].name), name) < 0 )
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    for (uint32_t i = low; i < header->count && strcmp (fileindex_string (this, records[i].name), name) == 0; i++)
+    {
+        const char * path = fileindex_string (this, records[i].path);
+
+        if ( under_prefix (path, prefix, prefixLen) == false || g_hash_table_contains (this->removed, path))
+        {
+            continue;
+        }
+        if ( seen != NULL)
+        {
+            g_hash_table_add (seen, (gpointer)path);
+        }
+        fileindex_result (this, path, records[i].type, result);
+    }
+
+    if ( seen != NULL)
+    {
+        GHashTableIter iter;
+        gpointer       key, value;
+
+        g_hash_table_iter_init (&iter, this->added);
+        while (g_hash_table_iter_next (&iter, &key, &value))
+        {
+            const char * path  = (const char *)key;
+            const char * slash = strrchr (path, '/');
+            const char * base  = (slash != NULL) ? slash + 1 : path;
+
+            if ( strcmp (base, name) == 0 && under_prefix (path, prefix, prefixLen) && g_hash_table_contains (seen, path) == false )
+            {
+                fileindex_result (this, path, (unsigned char)GPOINTER_TO_INT (value), result);
+            }
+        }
+        g_hash_table_destroy (seen);
+    }
+
+    *result = g_list_reverse (*result);
+    return true;
+}
+
+static bool fileindex_answer (SearchContext * context)
+{
+    bool    answered = false;
+    GList * found    = NULL;
+    GList * tried    = NULL;
+
+    g_mutex_lock (&fileIndexLock);
+    while (answered == false)
+    {
+        FileIndexExtends * this = NULL;
+        size_t             len  = 0;
+
+        for (GList * iter = fileIndexList; iter != NULL && this == NULL; iter = iter->next)
+        {
+            FileIndexExtends * index = (FileIndexExtends *)iter->data;
+
+            len = strlen (index->root);
+            if ( g_list_find (tried, index) == NULL && strncmp (context->root, index->root, len) == 0
+                 && (context->root[len] == '\0' || context->root[len] == '/'))
+            {
+                this = index;
+            }
+        }
+        if ( this == NULL)
+        {
+            break;
+        }
+        tried = g_list_prepend (tried, this);
+
+        // index 를 잡은 후 목록 lock 을 놓아 index 를 다시 만드는 동안 다른 검색을 막지 않는다.
+        // DestroyFileIndex 는 목록에서 뺀 후 this->lock 을 기다리므로 this 는 사라지지 않는다.
+        g_mutex_lock (&this->lock);
+        g_mutex_unlock (&fileIndexLock);
+
+        answered = fileindex_lookup (this, context->root[len] == '/' ? context->root + len + 1 : "", context->name, &found);
+
+        g_mutex_unlock (&this->lock);
+        g_mutex_lock (&fileIndexLock);
+    }
+    g_mutex_unlock (&fileIndexLock);
+    g_list_free (tried);
+
+    if ( answered == false || context->callback == NULL)
+    {
+        context->result = found;
+        return answered;
+    }
+
+    for (GList * iter = found; iter != NULL; iter = iter->next)
+    {
+        if ( g_atomic_int_get (&context->stop) == 0 )
+        {
+            bool next = context->callback ((String)iter->data, context->user_data);
+
+            context->found++;
+            if ( next == false || (context->maxResults > 0 && context->found >= context->maxResults))
+            {
+                g_atomic_int_set (&context->stop, 1);
+            }
+        }
+    }
+    g_list_free_full (found, deleteSearchListElement);
+    return true;
+}
+
+FileIndex NewFileIndex (String root, String indexPath)
+{
+    if ( root == NULL || indexPath == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "root / index path not valid");
+        return NULL;
+    }
+
+    String rootPath = realpath (root, NULL);
+    if ( rootPath == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "target source file doesn't exist");
+        return NULL;
+    }
+
+    FileIndexExtends * this = (FileIndexExtends *)malloc (sizeof (FileIndexExtends));
+
+    this->index.Build  = buildFileIndex;
+    this->index.Search = searchFileIndex;
+
+    this->root    = rootPath;
+    this->path    = strdup (indexPath);
+    this->map     = NULL;
+    this->mapSize = 0;
+    this->inotify = -1;
+    this->changes = 0;
+    this->live    = false;
+    this->stale   = false;
+    this->added   = g_hash_table_new_full (g_str_hash, g_str_equal, free, NULL);
+    this->removed = g_hash_table_new_full (g_str_hash, g_str_equal, free, NULL);
+    this->watches = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, free);
+    this->building = false;
+    g_mutex_init (&this->lock);
+    g_cond_init (&this->built);
+
+    // 저장된 index 가 있으면 재사용하고 그 사이 변경된 directory 가 있을 때만 다시 만든다.
+    g_mutex_lock (&this->lock);
+    if ( fileindex_map (this))
+    {
+        fileindex_watch (this);
+    }
+    if ( this->map == NULL || this->stale )
+    {
+        fileindex_build (this);
+    }
+    g_mutex_unlock (&this->lock);
+
+    g_mutex_lock (&fileIndexLock);
+    fileIndexList = g_list_prepend (fileIndexList, this);
+    g_mutex_unlock (&fileIndexLock);
+
+    return &this->index;
+}
+
+void DestroyFileIndex (FileIndex this_gen)
+{
+    if ( this_gen != NULL)
+    {
+        FileIndexExtends * this = (FileIndexExtends *)this_gen;
+
+        g_mutex_lock (&fileIndexLock);
+        fileIndexList = g_list_remove (fileIndexList, this);
+        g_mutex_unlock (&fileIndexLock);
+
+        // 진행중인 검색과 index 생성이 끝날 때까지 기다린다.
+        g_mutex_lock (&this->lock);
+        while (this->building)
+        {
+            g_cond_wait (&this->built, &this->lock);
+        }
+        g_mutex_unlock (&this->lock);
+
+        fileindex_unmap (this);
+        if ( this->inotify != -1 )
+        {
+            close (this->inotify);
+        }
+        g_hash_table_destroy (this->added);
+        g_hash_table_destroy (this->removed);
+        g_hash_table_destroy (this->watches);
+        g_mutex_clear (&this->lock);
+        g_cond_clear (&this->built);
+        free (this->root);
+        free (this->path);
+        free (this);
+    }
+}
+
+bool buildFileIndex (FileIndex this_gen)
+{
+    if ( this_gen != NULL)
+    {
+        FileIndexExtends * this = (FileIndexExtends *)this_gen;
+
+        g_mutex_lock (&this->lock);
+        bool ret = fileindex_build (this);
+        g_mutex_unlock (&this->lock);
+
+        return ret;
+    }
+    dlog_print (DLOG_INFO, "DIT", "NULL module");
+    return false;
+}
+
+GList * searchFileIndex (FileIndex this_gen, String name)
+{
+    if ( this_gen != NULL && name != NULL)
+    {
+        FileIndexExtends * this   = (FileIndexExtends *)this_gen;
+        GList            * result = NULL;
+
+        g_mutex_lock (&this->lock);
+        fileindex_lookup (this, "", name, &result);
+        g_mutex_unlock (&this->lock);
+
+        return result;
+    }
+    dlog_print (DLOG_INFO, "DIT", "NULL module / name");
+    return NULL;
+}
+
+// file watcher : inotify event 를 경로별로 합쳐서 batch 로 전달한다.
+typedef struct _WatchEntry
+{
+    int    wd;
+    String path;
+    bool   recursive;
+
+} WatchEntry;
+
+typedef struct _WatchBatch
+{
+    GQueue       queue;    // FileChange *, 발생 순서
+    GHashTable * changes;  // 경로 -> FileChange *
+    bool         overflow;
+    gint64       first;
+    gint64       last;
+
+} WatchBatch;
+
+static void deleteWatchEntry (gpointer data)
+{
+    WatchEntry * entry = (WatchEntry *)data;
+
+    free (entry->path);
+    free (entry);
+}
+
+static void watcher_forget (FileWatcherExtends * this, WatchEntry * entry)
+{
+    g_hash_table_remove (this->paths, entry->path);
+    g_hash_table_remove (this->watches, GINT_TO_POINTER (entry->wd));
+}
+
+// added 가 NULL 이 아니면 이 호출에서 새로 만든 watch 의 wd 를 추가한다.
+static bool watcher_add (FileWatcherExtends * this, String path, bool recursive, GList ** added)
+{
+    WatchEntry * entry = (WatchEntry *)g_hash_table_lookup (this->paths, path);
+
+    if ( entry != NULL)
+    {
+        entry->recursive |= recursive;
+        return true;
+    }
+
+    if ((int)g_hash_table_size (this->watches) >= this->limit )
+    {
+        dlog_print (DLOG_INFO, "DIT", "watch limit (%d) exceeded : %s", this->limit, path);
+        return false;
+    }
+
+    int wd = inotify_add_watch (this->inotify, path, FILE_WATCHER_MASK | (recursive ? IN_ONLYDIR : 0));
+    if ( wd == -1 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "can not watch %s : %s", path, strerror (errno));
+        return false;
+    }
+
+    // 같은 inode 를 다른 경로로 추가한 경우 kernel 은 같은 wd 를 돌려준다.
+    WatchEntry * old = (WatchEntry *)g_hash_table_lookup (this->watches, GINT_TO_POINTER (wd));
+    if ( old != NULL)
+    {
+        watcher_forget (this, old);
+    }
+    else if ( added != NULL)
+    {
+        *added = g_list_prepend (*added, GINT_TO_POINTER (wd));
+    }
+
+    entry            = (WatchEntry *)malloc (sizeof (WatchEntry));
+    entry->wd        = wd;
+    entry->path      = strdup (path);
+    entry->recursive = recursive;
+
+    g_hash_table_replace (this->watches, GINT_TO_POINTER (wd), entry);
+    g_hash_table_replace (this->paths, entry->path, entry);
+    return true;
+}
+
+static void watcher_remove_tree (FileWatcherExtends * this, String path)
+{
+    GHashTableIter iter;
+    gpointer       value;
+    GList        * list = NULL;
+    size_t         len  = strlen (path);
+
+    g_hash_table_iter_init (&iter, this->watches);
+    while (g_hash_table_iter_next (&iter, NULL, &value))
+    {
+        WatchEntry * entry = (WatchEntry *)value;
+
+        if ( strncmp (entry->path, path, len) == 0 && (entry->path[len] == '\0' || entry->path[len] == '/'))
+        {
+            list = g_list_prepend (list, entry);
+        }
+    }
+
+    for (GList * iter = list; iter != NULL; iter = iter->next)
+    {
+        WatchEntry * entry = (WatchEntry *)iter->data;
+
+        inotify_rm_watch (this->inotify, entry->wd);
+        watcher_forget (this, entry);
+    }
+    g_list_free (list);
+}
+
+// 실패한 추가를 되돌릴 때 이 호출에서 새로 만든 watch 만 지우고 이전부터 있던 watch 는 남긴다.
+static void watcher_rollback (FileWatcherExtends * this, GList * added)
+{
+    for (GList * iter = added; iter != NULL; iter = iter->next)
+    {
+        WatchEntry * entry = (WatchEntry *)g_hash_table_lookup (this->watches, iter->data);
+
+        if ( entry != NULL)
+        {
+            inotify_rm_watch (this->inotify, entry->wd);
+            watcher_forget (this, entry);
+        }
+    }
+}
+
+static void watcher_record (WatchBatch * batch, String path, int events, bool isDirectory)
+{
+    FileChange * change = NULL;
+
+    if ( path == NULL)
+    {
+        if ( batch->overflow )
+        {
+            return;
+        }
+        batch->overflow = true;
+    }
+    else
+    {
+        change = (FileChange *)g_hash_table_lookup (batch->changes, path);
+    }
+
+    if ( change != NULL)
+    {
+        change->events      |= events;
+        change->isDirectory |= isDirectory;
+        free (path);
+    }
+    else
+    {
+        change              = (FileChange *)malloc (sizeof (FileChange));
+        change->path        = path;
+        change->events      = events;
+        change->isDirectory = isDirectory;
+
+        g_queue_push_tail (&batch->queue, change);
+        if ( path != NULL)
+        {
+            g_hash_table_replace (batch->changes, path, change);
+        }
+    }
+
+    batch->last = g_get_monotonic_time ();
+    if ( batch->queue.length == 1 )
+    {
+        batch->first = batch->last;
+    }
+}
+
+static gint compare_index_path (gconstpointer a, gconstpointer b)
+{
+    return strcmp (((const IndexEntry *)a)->path, ((const IndexEntry *)b)->path);
+}
+
+// recursive 감시에서는 directory 를 감시하기 전에 생긴 하위 항목들도 생성으로 전달한다.
+static bool watcher_add_tree (FileWatcherExtends * this, String path, WatchBatch * batch, GList ** added)
+{
+    SearchContext context;
+    bool          ret = true;
+
+    if ( watcher_add (this, path, true, added) == false )
+    {
+        return false;
+    }
+
+    memset (&context, 0, sizeof (SearchContext));
+    context.collect = true;
+    if ( search_run (path, &context) == false )
+    {
+        return true;
+    }
+
+    // 상위 directory 가 하위 항목보다 먼저 전달되도록 경로 순으로 정렬한다.
+    context.result = g_list_sort (context.result, compare_index_path);
+
+    for (GList * iter = context.result; iter != NULL; iter = iter->next)
+    {
+        IndexEntry * item = (IndexEntry *)iter->data;
+        String       full = join_path (path, item->path);
+
+        if ( item->type == DT_DIR && ret )
+        {
+            ret = watcher_add (this, full, true, added);
+        }
+
+        if ( batch != NULL)
+        {
+            watcher_record (batch, full, FILE_CHANGE_CREATED, item->type == DT_DIR);
+        }
+        else
+        {
+            free (full);
+        }
+    }
+    g_list_free_full (context.result, deleteIndexEntry);
+
+    return ret;
+}
+
+static void watcher_apply (FileWatcherExtends * this, struct inotify_event * event, WatchBatch * batch)
+{
+    if ( event->mask & IN_Q_OVERFLOW )
+    {
+        watcher_record (batch, NULL, FILE_CHANGE_OVERFLOW, false);
+        return;
+    }
+
+    WatchEntry * entry = (WatchEntry *)g_hash_table_lookup (this->watches, GINT_TO_POINTER (event->wd));
+    if ( entry == NULL)
+    {
+        return;
+    }
+
+    if ( event->mask & IN_IGNORED )
+    {
+        watcher_forget (this, entry);
+        return;
+    }
+
+    String path        = (event->len > 0) ? join_path (entry->path, event->name) : strdup (entry->path);
+    bool   isDirectory = (event->mask & IN_ISDIR) != 0 || (event->len == 0 && entry->recursive);
+    int    events      = 0;
+
+    events |= (event->mask & IN_CREATE) ? FILE_CHANGE_CREATED : 0;
+    events |= (event->mask & (IN_DELETE | IN_DELETE_SELF)) ? FILE_CHANGE_DELETED : 0;
+    events |= (event->mask & IN_MODIFY) ? FILE_CHANGE_MODIFIED : 0;
+    events |= (event->mask & IN_ATTRIB) ? FILE_CHANGE_ATTRIBUTE : 0;
+    events |= (event->mask & (IN_MOVED_FROM | IN_MOVE_SELF)) ? FILE_CHANGE_MOVED_FROM : 0;
+    events |= (event->mask & IN_MOVED_TO) ? FILE_CHANGE_MOVED_TO : 0;
+
+    watcher_record (batch, strdup (path), events, isDirectory);
+
+    if ( entry->recursive && (event->mask & IN_ISDIR) && event->len > 0 )
+    {
+        if ( event->mask & (IN_CREATE | IN_MOVED_TO))
+        {
+            if ( watcher_add_tree (this, path, batch, NULL) == false )
+            {
+                watcher_record (batch, strdup (path), FILE_CHANGE_OVERFLOW, true);
+            }
+        }
+        else if ( event->mask & IN_MOVED_FROM )
+        {
+            watcher_remove_tree (this, path);
+        }
+    }
+
+    // 감시 중인 directory 자체가 옮겨지면 새 경로를 알 수 없으므로 그 아래의 감시를 지운다.
+    // 감시 중인 상위 directory 안에서 옮겨졌다면 IN_MOVED_FROM / IN_MOVED_TO 로 이미 새 경로에 다시 추가되었다.
+    if ( event->mask & IN_MOVE_SELF )
+    {
+        watcher_remove_tree (this, path);
+    }
+    free (path);
+}
+
+static void watcher_flush (FileWatcherExtends * this, WatchBatch * batch)
+{
+    int          count   = batch->queue.length;
+    FileChange * changes = (FileChange *)malloc (count * sizeof (FileChange));
+
+    for (int i = 0; i < count; i++)
+    {
+        FileChange * change = (FileChange *)g_queue_pop_head (&batch->queue);
+
+        changes[i] = *change;
+        free (change);
+    }
+    g_hash_table_remove_all (batch->changes);
+    batch->overflow = false;
+
+    this->callback (changes, count, this->user_data);
+
+    for (int i = 0; i < count; i++)
+    {
+        free (changes[i].path);
+    }
+    free (changes);
+}
+
+static gpointer watcher_run (gpointer data)
+{
+    FileWatcherExtends * this = (FileWatcherExtends *)data;
+    struct pollfd        fds[2];
+    WatchBatch           batch;
+    alignas (struct inotify_event) char buff[FILE_INDEX_EVENT_SIZE];
+
+    fds[0].fd     = this->inotify;
+    fds[0].events = POLLIN;
+    fds[1].fd     = this->wakeup[0];
+    fds[1].events = POLLIN;
+
+    memset (&batch, 0, sizeof (WatchBatch));
+    g_queue_init (&batch.queue);
+    batch.changes = g_hash_table_new (g_str_hash, g_str_equal);
+
+    while (true)
+    {
+        int timeout = -1;
+
+        // 마지막 event 후 latency 동안 조용하거나 첫 event 후 4 * latency 가 지나면 전달한다.
+        if ( batch.queue.length > 0 )
+        {
+            gint64 now      = g_get_monotonic_time ();
+            gint64 deadline = MIN (batch.last + this->latency * 1000, batch.first + this->latency * 4000);
+
+            if ( now >= deadline || batch.queue.length >= FILE_WATCHER_BATCH_MAX )
+            {
+                watcher_flush (this, &batch);
+                continue;
+            }
+            timeout = (int)((deadline - now + 999) / 1000);
+        }
+
+        if ( poll (fds, 2, timeout) == -1 && errno != EINTR )
+        {
+            dlog_print (DLOG_INFO, "DIT", "file watcher poll failed : %s", strerror (errno));
+            break;
+        }
+
+        if ( fds[1].revents != 0 )
+        {
+            break;
+        }
+
+        if ( fds[0].revents & POLLIN )
+        {
+            ssize_t len;
+
+            g_mutex_lock (&this->lock);
+            while ((len = read (this->inotify, buff, sizeof (buff))) > 0)
+            {
+                for (char * pos = buff; pos < buff + len;)
+                {
+                    struct inotify_event * event = (struct inotify_event *)pos;
+
+                    watcher_apply (this, event, &batch);
+                    pos += sizeof (struct inotify_event) + event->len;
+                }
+            }
+            g_mutex_unlock (&this->lock);
+        }
+    }
+
+    if ( batch.queue.length > 0 )
+    {
+        watcher_flush (this, &batch);
+    }
+    g_hash_table_destroy (batch.changes);
+
+    return NULL;
+}
+
+FileWatcher NewFileWatcher (void)
+{
+    FileWatcherExtends * this = (FileWatcherExtends *)malloc (sizeof (FileWatcherExtends));
+
+    this->watcher.addWatch       = addFileWatch;
+    this->watcher.removeWatch    = removeFileWatch;
+    this->watcher.setLimit       = setFileWatchLimit;
+    this->watcher.addCallback    = addFileWatcherCallback;
+    this->watcher.detachCallback = detachFileWatcherCallback;
+    this->watcher.On             = FileWatcherOn;
+    this->watcher.Off            = FileWatcherOff;
+
+    this->watches   = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, deleteWatchEntry);
+    this->paths     = g_hash_table_new (g_str_hash, g_str_equal);
+    this->thread    = NULL;
+    this->callback  = NULL;
+    this->user_data = NULL;
+    this->latency   = FILE_WATCHER_LATENCY;
+    this->limit     = FILE_WATCHER_LIMIT;
+    this->activated = false;
+    g_mutex_init (&this->lock);
+
+    this->inotify = inotify_init1 (IN_NONBLOCK | IN_CLOEXEC);
+    if ( this->inotify == -1 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "inotify_init1 failed : %s", strerror (errno));
+    }
+    if ( pipe2 (this->wakeup, O_CLOEXEC) == -1 )
+    {
+        this->wakeup[0] = this->wakeup[1] = -1;
+        dlog_print (DLOG_INFO, "DIT", "pipe2 failed : %s", strerror (errno));
+    }
+
+    return &this->watcher;
+}
+
+void DestroyFileWatcher (FileWatcher this_gen)
+{
+    if ( this_gen != NULL)
+    {
+        FileWatcherExtends * this = (FileWatcherExtends *)this_gen;
+
+        FileWatcherOff (this_gen);
+
+        g_hash_table_destroy (this->paths);
+        g_hash_table_destroy (this->watches);
+        g_mutex_clear (&this->lock);
+
+        if ( this->inotify != -1 )
+        {
+            close (this->inotify);
+        }
+        if ( this->wakeup[0] != -1 )
+        {
+            close (this->wakeup[0]);
+            close (this->wakeup[1]);
+        }
+        free (this);
+    }
+}
+
+bool addFileWatch (FileWatcher this_gen, String path, bool recursive)
+{
+    if ( this_gen == NULL || path == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "NULL module / path");
+        return false;
+    }
+
+    FileWatcherExtends * this = (FileWatcherExtends *)this_gen;
+
+    String fullPath = realpath (path, NULL);
+    if ( fullPath == NULL || this->inotify == -1 )
+    {
+        free (fullPath);
+        dlog_print (DLOG_INFO, "DIT", "can not watch %s", path);
+        return false;
+    }
+
+    GList * added = NULL;
+
+    g_mutex_lock (&this->lock);
+    bool ret = recursive ? watcher_add_tree (this, fullPath, NULL, &added) : watcher_add (this, fullPath, false, NULL);
+    if ( ret == false )
+    {
+        watcher_rollback (this, added);
+    }
+    g_mutex_unlock (&this->lock);
+
+    g_list_free (added);
+    free (fullPath);
+    return ret;
+}
+
+bool removeFileWatch (FileWatcher this_gen, String path)
+{
+    if ( this_gen == NULL || path == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "NULL module / path");
+        return false;
+    }
+
+    FileWatcherExtends * this     = (FileWatcherExtends *)this_gen;
+    String               fullPath = realpath (path, NULL);
+
+    g_mutex_lock (&this->lock);
+    watcher_remove_tree (this, fullPath != NULL ? fullPath : path);
+    g_mutex_unlock (&this->lock);
+
+    free (fullPath);
+    return true;
+}
+
+bool setFileWatchLimit (FileWatcher this_gen, int maxWatches)
+{
+    if ( this_gen == NULL || maxWatches <= 0 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "NULL module / invalid limit");
+        return false;
+    }
+
+    FileWatcherExtends * this = (FileWatcherExtends *)this_gen;
+
+    g_mutex_lock (&this->lock);
+    this->limit = maxWatches;
+    g_mutex_unlock (&this->lock);
+
+    return true;
+}
+
+bool addFileWatcherCallback (FileWatcher this_gen, FileWatcherCallback callback, int latency, void * data)
+{
+    if ( this_gen == NULL || callback == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "NULL module / callback");
+        return false;
+    }
+
+    FileWatcherExtends * this = (FileWatcherExtends *)this_gen;
+
+    if ( this->activated )
+    {
+        dlog_print (DLOG_INFO, "DIT", "file watcher is running");
+        return false;
+    }
+
+    this->callback  = callback;
+    this->user_data = data;
+    this->latency   = (latency > 0) ? latency : FILE_WATCHER_LATENCY;
+
+    return true;
+}
+
+bool detachFileWatcherCallback (FileWatcher this_gen)
+{
+    if ( this_gen == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "NULL module");
+        return false;
+    }
+
+    FileWatcherExtends * this = (FileWatcherExtends *)this_gen;
+
+    if ( this->activated )
+    {
+        dlog_print (DLOG_INFO, "DIT", "file watcher is running");
+        return false;
+    }
+
+    this->callback  = NULL;
+    this->user_data = NULL;
+
+    return true;
+}
+
+bool FileWatcherOn (FileWatcher this_gen)
+{
+    if ( this_gen == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "NULL module");
+        return false;
+    }
+
+    FileWatcherExtends * this = (FileWatcherExtends *)this_gen;
+
+    if ( this->activated )
+    {
+        return true;
+    }
+
+    if ( this->callback == NULL || this->inotify == -1 || this->wakeup[0] == -1 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "file watcher callback not registered");
+        return false;
+    }
+
+    this->thread = g_thread_try_new ("FileWatcher", watcher_run, this, NULL);
+    if ( this->thread == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "can not start file watcher thread");
+        return false;
+    }
+    this->activated = true;
+
+    return true;
+}
+
+bool FileWatcherOff (FileWatcher this_gen)
+{
+    if ( this_gen == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "NULL module");
+        return false;
+    }
+
+    FileWatcherExtends * this = (FileWatcherExtends *)this_gen;
+    char                 wake = 0;
+
+    if ( this->activated == false )
+    {
+        return true;
+    }
+
+    while (write (this->wakeup[1], &wake, 1) == -1 && errno == EINTR)
+    {
+    }
+    g_thread_join (this->thread);
+    while (read (this->wakeup[0], &wake, 1) == -1 && errno == EINTR)
+    {
+    }
+
+    this->thread    = NULL;
+    this->activated = false;
+
+    return true;
+}
+
+//callbacking function
+static void deleteSearchListElement (gpointer data)
+{
+    free (data);
+
+}
+
+void deleteSearchedList (GList * searchList)
+{
+
+    g_list_free_full (searchList, deleteSearchListElement);
+
+}
+
+// player pool : 곧 재생할 URI 의 player 를 worker 가 미리 prepare 해 둔다.
+typedef struct _PlayerPoolEntry
+{
+    String   uri;
+    player_h player;
+    bool     wanted; // 마지막 Preload 목록에 있음
+
+} PlayerPoolEntry;
+
+static void player_pool_clear_pending (PlayerPoolExtends * this)
+{
+    String uri;
+
+    while ((uri = (String)g_queue_pop_head (&this->pending)) != NULL)
+    {
+        free (uri);
+    }
+}
+
+static void player_pool_entry_free (PlayerPoolEntry * entry)
+{
+    player_unprepare (entry->player);
+    player_destroy (entry->player);
+    free (entry->uri);
+    free (entry);
+}
+
+static GList * player_pool_find (PlayerPoolExtends * this, String uri)
+{
+    for (GList * link = this->entries.head; link != NULL; link = link->next)
+    {
+        if ( strcmp (((PlayerPoolEntry *)link->data)->uri, uri) == 0 )
+        {
+            return link;
+        }
+    }
+    return NULL;
+}
+
+static bool player_pool_full (PlayerPoolExtends * this)
+{
+    return (int)this->entries.length > this->maxPlayers || (this->budget > 0 && this->entries.length * this->cost > this->budget);
+}
+
+static void player_pool_remove (PlayerPoolExtends * this, GList * link)
+{
+    PlayerPoolEntry * entry = (PlayerPoolEntry *)link->data;
+
+    g_queue_delete_link (&this->entries, link);
+    player_pool_entry_free (entry);
+}
+
+// 한도를 넘으면 Preload 목록에 없는 player 부터 오래된 순으로 버린다. lock 을 잡고 호출해야 한다.
+static void player_pool_evict (PlayerPoolExtends * this, GList * keep)
+{
+    GList * link = this->entries.tail;
+
+    while (link != NULL && player_pool_full (this))
+    {
+        GList * prev = link->prev;
+
+        if ( link != keep && ((PlayerPoolEntry *)link->data)->wanted == false )
+        {
+            player_pool_remove (this, link);
+        }
+        link = prev;
+    }
+}
+
+static gpointer player_pool_run (gpointer data)
+{
+    PlayerPoolExtends * this = (PlayerPoolExtends *)data;
+
+    g_mutex_lock (&this->lock);
+    while (true)
+    {
+        while (this->stop == false && g_queue_is_empty (&this->pending))
+        {
+            g_cond_wait (&this->cond, &this->lock);
+        }
+        if ( this->stop )
+        {
+            break;
+        }
+
+        String uri = (String)g_queue_pop_head (&this->pending);
+
+        this->preparing       = uri;
+        this->preparingWanted = true;
+        g_mutex_unlock (&this->lock);
+
+        // prepare 는 lock 밖에서 하여 Play 쪽의 take 가 다른 URI 를 기다리지 않게 한다.
+        // Evas Object 는 main loop 에서만 다룰 수 있으므로 display 는 take 한 쪽에서 설정한다.
+        player_h       player = NULL;
+        player_error_e ret    = player_create (&player);
+
+        if ( ret == PLAYER_ERROR_NONE )
+        {
+            ret = player_set_uri (player, uri);
+        }
+        if ( ret == PLAYER_ERROR_NONE )
+        {
+            ret = player_prepare (player);
+        }
+
+        g_mutex_lock (&this->lock);
+        this->preparing = NULL;
+
+        if ( ret != PLAYER_ERROR_NONE )
+        {
+            dlog_print (DLOG_INFO, "DIT", "preload failed : %s : %s", uri, PlayerErrorCheck (ret));
+            if ( player != NULL)
+            {
+                player_destroy (player);
+            }
+            free (uri);
+        }
+        else
+        {
+            PlayerPoolEntry * entry = (PlayerPoolEntry *)malloc (sizeof (PlayerPoolEntry));
+
+            entry->uri    = uri;
+            entry->player = player;
+            entry->wanted = this->preparingWanted;
+
+            g_queue_push_head (&this->entries, entry);
+            player_pool_evict (this, this->entries.head);
+
+            // 목록의 player 만으로 한도를 넘으면 방금 만든 것을 버리고 나머지 preload 도 그만둔다.
+            if ( player_pool_full (this))
+            {
+                dlog_print (DLOG_INFO, "DIT", "player pool memory budget exceeded : %u x %zu / %zu", this->entries.length, this->cost, this->budget);
+                player_pool_remove (this, this->entries.head);
+                player_pool_clear_pending (this);
+            }
+        }
+        g_cond_broadcast (&this->cond);
+    }
+    g_mutex_unlock (&this->lock);
+
+    return NULL;
+}
+
+// uri 로 prepare 된 player 를 pool 에서 꺼낸다. prepare 중이면 끝날 때까지 기다리고
+// 아직 순서를 기다리는 중이면 호출한 쪽이 직접 prepare 하므로 목록에서 뺀다.
+// EvasObject 가 NULL 이 아니면 pool 에 설정된 Evas Object 를 돌려준다.
+static player_h player_pool_take (PlayerPool this_gen, String uri, Evas_Object ** EvasObject)
+{
+    PlayerPoolExtends * this   = (PlayerPoolExtends *)this_gen;
+    player_h            player = NULL;
+
+    g_mutex_lock (&this->lock);
+    while (this->preparing != NULL && strcmp (this->preparing, uri) == 0)
+    {
+        g_cond_wait (&this->cond, &this->lock);
+    }
+
+    for (GList * link = this->pending.head; link != NULL; link = link->next)
+    {
+        if ( strcmp ((String)link->data, uri) == 0 )
+        {
+            free (link->data);
+            g_queue_delete_link (&this->pending, link);
+            break;
+        }
+    }
+
+    GList * link = player_pool_find (this, uri);
+    if ( link != NULL)
+    {
+        PlayerPoolEntry * entry = (PlayerPoolEntry *)link->data;
+
+        player = entry->player;
+        g_queue_delete_link (&this->entries, link);
+        free (entry->uri);
+        free (entry);
+    }
+    if ( EvasObject != NULL)
+    {
+        *EvasObject = this->EvasObject;
+    }
+    g_mutex_unlock (&this->lock);
+
+    return player;
+}
+
+// pool 에 uri 로 prepare 된 player 가 있으면 handle 을 교체하고 이전 player 를 소멸시킨다.
+// EvasObject 가 NULL 이 아니면 pool 에 설정된 Evas Object 를 돌려준다.
+static bool player_swap_prepared (PlayerPool pool, player_h * handle, String uri, Evas_Object ** EvasObject)
+{
+    player_h prepared = (pool != NULL) ? player_pool_take (pool, uri, EvasObject) : NULL;
+
+    if ( prepared == NULL)
+    {
+        return false;
+    }
+
+    player_unprepare (*handle);
+    player_destroy (*handle);
+    *handle = prepared;
+    return true;
+}
+
+PlayerPool NewPlayerPool (int maxPlayers, size_t memoryBudget, size_t playerCost)
+{
+    PlayerPoolExtends * this = (PlayerPoolExtends *)malloc (sizeof (PlayerPoolExtends));
+
+    this->pool.Preload   = preloadPlayerPool;
+    this->pool.setObject = setPlayerPoolObject;
+
+    this->maxPlayers      = (maxPlayers > 0) ? maxPlayers : PLAYER_POOL_PLAYERS;
+    this->budget          = memoryBudget;
+    this->cost            = (playerCost > 0) ? playerCost : PLAYER_POOL_COST;
+    this->preparing       = NULL;
+    this->preparingWanted = false;
+    this->EvasObject      = NULL;
+    this->thread          = NULL;
+    this->stop            = false;
+    g_queue_init (&this->entries);
+    g_queue_init (&this->pending);
+    g_mutex_init (&this->lock);
+    g_cond_init (&this->cond);
+
+    return &this->pool;
+}
+
+void DestroyPlayerPool (PlayerPool this_gen)
+{
+    if ( this_gen != NULL)
+    {
+        PlayerPoolExtends * this = (PlayerPoolExtends *)this_gen;
+        PlayerPoolEntry   * entry;
+
+        g_mutex_lock (&this->lock);
+        this->stop = true;
+        g_cond_broadcast (&this->cond);
+        g_mutex_unlock (&this->lock);
+
+        if ( this->thread != NULL)
+        {
+            g_thread_join (this->thread);
+        }
+
+        while ((entry = (PlayerPoolEntry *)g_queue_pop_head (&this->entries)) != NULL)
+        {
+            player_pool_entry_free (entry);
+        }
+        player_pool_clear_pending (this);
+
+        g_cond_clear (&this->cond);
+        g_mutex_clear (&this->lock);
+        free (this);
+    }
+}
+
+bool preloadPlayerPool (PlayerPool this_gen, String * uris, int count)
+{
+    if ( this_gen == NULL || uris == NULL || count < 0 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "PlayerPool / uris not valid");
+        return false;
+    }
+
+    PlayerPoolExtends * this  = (PlayerPoolExtends *)this_gen;
+    int                 limit = (count < this->maxPlayers) ? count : this->maxPlayers;
+
+    g_mutex_lock (&this->lock);
+    if ( this->thread == NULL)
+    {
+        this->thread = g_thread_try_new ("PlayerPool", player_pool_run, this, NULL);
+        if ( this->thread == NULL)
+        {
+            g_mutex_unlock (&this->lock);
+            dlog_print (DLOG_INFO, "DIT", "can not start preload thread");
+            return false;
+        }
+    }
+
+    // 이전 목록은 버리고 이번 목록에 있는 player 만 보호한다.
+    player_pool_clear_pending (this);
+    this->preparingWanted = false;
+    for (GList * link = this->entries.head; link != NULL; link = link->next)
+    {
+        ((PlayerPoolEntry *)link->data)->wanted = false;
+    }
+
+    // 뒤에서부터 head 로 옮겨 uris[0] 이 가장 최근에 사용한 항목이 되게 한다.
+    for (int i = limit - 1; i >= 0; i--)
+    {
+        GList * link = (uris[i] != NULL) ? player_pool_find (this, uris[i]) : NULL;
+
+        if ( link != NULL)
+        {
+            ((PlayerPoolEntry *)link->data)->wanted = true;
+            g_queue_unlink (&this->entries, link);
+            g_queue_push_head_link (&this->entries, link);
+        }
+    }
+
+    for (int i = 0; i < limit; i++)
+    {
+        if ( uris[i] == NULL || player_pool_find (this, uris[i]) != NULL)
+        {
+            continue;
+        }
+        if ( this->preparing != NULL && strcmp (this->preparing, uris[i]) == 0 )
+        {
+            this->preparingWanted = true;
+            continue;
+        }
+        g_queue_push_tail (&this->pending, strdup (uris[i]));
+    }
+    g_cond_broadcast (&this->cond);
+    g_mutex_unlock (&this->lock);
+
+    return true;
+}
+
+bool setPlayerPoolObject (PlayerPool this_gen, Evas_Object * EvasObject)
+{
+    if ( this_gen == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "NULL module");
+        return false;
+    }
+
+    PlayerPoolExtends * this = (PlayerPoolExtends *)this_gen;
+
+    g_mutex_lock (&this->lock);
+    this->EvasObject = EvasObject;
+    g_mutex_unlock (&this->lock);
+
+    return true;
+}
+
+// media metadata : 처음 요청할 때 모든 항목을 한번에 꺼내 객체에 보관하고 이후에는 복사본을 돌려준다.
+static void media_metadata_clear (String * metadata, bool * loaded)
+{
+    for (int i = 0; i < MEDIA_METADATA_COUNT; i++)
+    {
+        free (metadata[i]);
+        metadata[i] = NULL;
+    }
+    *loaded = false;
+}
+
+static void media_metadata_load (metadata_extractor_h handle, String * metadata, bool * loaded)
+{
+    for (int i = 0; i < MEDIA_METADATA_COUNT; i++)
+    {
+        int ret = metadata_extractor_get_metadata (handle, (metadata_extractor_attr_e)i, &metadata[i]);
+
+        if ( ret != METADATA_EXTRACTOR_ERROR_NONE )
+        {
+            metadata[i] = NULL;
+        }
+    }
+    *loaded = true;
+}
+
+static String media_metadata_get (metadata_extractor_h handle, String * metadata, bool * loaded, metadata_extractor_attr_e element)
+{
+    String value = NULL;
+
+    // cache 범위 밖의 항목은 그때마다 꺼낸다.
+    if ((unsigned int)element >= MEDIA_METADATA_COUNT )
+    {
+        int ret = metadata_extractor_get_metadata (handle, element, &value);
+
+        if ( ret != METADATA_EXTRACTOR_ERROR_NONE )
+        {
+            dlog_print (DLOG_INFO, "DIT", "metadata_extractor_get_metadata failed : %d", ret);
+            return NULL;
+        }
+        return value;
+    }
+
+    if ( *loaded == false )
+    {
+        media_metadata_load (handle, metadata, loaded);
+    }
+    return (metadata[element] != NULL) ? strdup (metadata[element]) : NULL;
+}
+
+Video NewVideo (void)
+{
+
+    VideoExtends * this = (VideoExtends *)malloc (sizeof (VideoExtends));
+
+    this->video.getInfo   = getVideoInfo;
+    this->video.Pause     = pauseVideo;
+    this->video.Play      = playVideo;
+    this->video.Stop      = stopVideo;
+    this->video.setURI    = setVideoURI;
+    this->video.setObject = setEvasObject;
+    this->video.setPool   = setVideoPlayerPool;
+
+    this->videoMetadataHandle = NULL;
+    this->player_handle       = NULL;
+    this->uri                 = NULL;
+    this->EvasObject          = NULL;
+    this->pool                = NULL;
+    this->metadataLoaded      = false;
+    memset (this->metadata, 0, sizeof (this->metadata));
+
+    player_create (&this->player_handle);
+    metadata_extractor_create (&this->videoMetadataHandle);
+
+    return &this->video;
+}
+
+void DestroyVideo (Video this_gen)
+{
+
+    if ( NULL != this_gen )
+    {
+
+        VideoExtends * this = (VideoExtends *)this_gen;
+
+        metadata_extractor_destroy (this->videoMetadataHandle);
+        media_metadata_clear (this->metadata, &this->metadataLoaded);
+        player_unprepare (this->player_handle);
+        player_destroy (this->player_handle);
+
+        if ( this->uri != NULL)
+        {
+            free (this->uri);
+        }
+
+        free (this);
+    }
+}
+
+bool playVideo (Video this_gen)
+{
+    if ( this_gen != NULL)
+    {
+        VideoExtends * this = (VideoExtends *)this_gen;
+
+        player_error_e ret = PLAYER_ERROR_NONE;
+
+        ret = player_prepare (this->player_handle);
+        if ( ret != PLAYER_ERROR_NONE && ret != PLAYER_ERROR_INVALID_STATE )
+        {
+            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (ret));
+            return false;
+        }
+
+        player_unset_completed_cb (this->player_handle);
+        player_set_completed_cb (this->player_handle, player_completed_callback, this->player_handle);
+
+        ret = player_start (this->player_handle);
+        if ( ret != PLAYER_ERROR_NONE && ret != PLAYER_ERROR_INVALID_STATE )
+        {
+            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (ret));
+            return false;
+        }
+        return true;
+    }
+    dlog_print (DLOG_INFO, "DIT", "NULL MODULE");
+    return false;
+}
+
+bool pauseVideo (Video this_gen)
+{
+    if ( this_gen != NULL)
+    {
+        VideoExtends * this = (VideoExtends *)this_gen;
+        player_error_e ret;
+        ret = player_pause (this->player_handle);
+        if ( ret != PLAYER_ERROR_NONE && ret != PLAYER_ERROR_INVALID_STATE )
+        {
+            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (ret));
+            return false;
+        }
+        return true;
+    }
+
+    dlog_print (DLOG_INFO, "DIT", "NULL module");
+    return false;
+
+}
+
+bool stopVideo (Video this_gen)
+{
+    if ( this_gen != NULL)
+    {
+        VideoExtends * this = (VideoExtends *)this_gen;
+        player_error_e ret;
+        ret = player_stop (this->player_handle);
+        if ( ret != PLAYER_ERROR_NONE && ret != PLAYER_ERROR_INVALID_STATE )
+        {
+            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (ret));
+            return false;
+        }
+        return true;
+    }
+    dlog_print (DLOG_INFO, "DIT", "NULL module");
+    return false;
+}
+
+String getVideoInfo (Video this_gen, metadata_extractor_attr_e element)
+{
+    if ( this_gen != NULL)
+    {
+        VideoExtends * this = (VideoExtends *)this_gen;
+
+        return media_metadata_get (this->videoMetadataHandle, this->metadata, &this->metadataLoaded, element);
+    }
+    dlog_print (DLOG_INFO, "DIT", "NULL module");
+    return NULL;
+}
+
+// display 를 설정한다. 이미 prepare 된 player 가 display 변경을 받지 않으면 unprepare 후 설정하고 다시 prepare 한다.
+static bool video_set_display (player_h player, Evas_Object * EvasObject)
+{
+    player_error_e ret = player_set_display (player, PLAYER_DISPLAY_TYPE_EVAS, GET_DISPLAY (EvasObject));
+
+    if ( ret == PLAYER_ERROR_INVALID_STATE )
+    {
+        player_unprepare (player);
+        ret = player_set_display (player, PLAYER_DISPLAY_TYPE_EVAS, GET_DISPLAY (EvasObject));
+        if ( ret == PLAYER_ERROR_NONE )
+        {
+            ret = player_prepare (player);
+        }
+    }
+    if ( ret != PLAYER_ERROR_NONE )
+    {
+        dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (ret));
+        return false;
+    }
+
+    ret = player_set_display_mode (player, PLAYER_DISPLAY_MODE_ORIGIN_OR_LETTER);
+    if ( ret != PLAYER_ERROR_NONE )
+    {
+        dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (ret));
+        return false;
+    }
+    return true;
+}
+
+bool setVideoURI (Video this_gen, String uri)
+{
+
+    if ( this_gen != NULL)
+    {
+        player_error_e ret = PLAYER_ERROR_NONE;
+
+        if ( NULL == uri )
+        {
+            dlog_print (DLOG_INFO, "DIT", "NULL URI");
+            return false;
+        }
+
+        VideoExtends * this = (VideoExtends *)this_gen;
+
+        if ( NULL != this->uri )
+        {
+            free (this->uri);
+        }
+        this->uri = malloc (strlen (uri) + sizeof (char));
+        strcpy (this->uri, uri);
+
+        Evas_Object * EvasObject = NULL;
+
+        if ( player_swap_prepared (this->pool, &this->player_handle, this->uri, &EvasObject))
+        {
+            // pool 의 worker 는 Evas Object 를 다룰 수 없으므로 display 는 여기서 설정한다.
+            if ( this->EvasObject != NULL)
+            {
+                EvasObject = this->EvasObject;
+            }
+            if ( EvasObject != NULL && video_set_display (this->player_handle, EvasObject) == false )
+            {
+                return false;
+            }
+        }
+        else
+        {
+            // 이전 URI 로 prepare 된 상태이면 URI 를 바꿀 수 없으므로 먼저 unprepare 한다.
+            player_unprepare (this->player_handle);
+            ret = player_set_uri (this->player_handle, this->uri);
+            if ( ret != PLAYER_ERROR_NONE )
+            {
+                dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (ret));
+                return false;
+            }
+        }
+        media_metadata_clear (this->metadata, &this->metadataLoaded);
+        ret = metadata_extractor_set_path (this->videoMetadataHandle, this->uri);
+        if ( ret != PLAYER_ERROR_NONE )
+        {
+            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (ret));
+            return false;
+        }
+        return true;
+    }
+    dlog_print (DLOG_INFO, "DIT", "NULL module");
+    return false;
+
+}
+
+bool setEvasObject (Video this_gen, Evas_Object * EvasObject)
+{
+
+    if ( this_gen != NULL)
+    {
+        VideoExtends * this = (VideoExtends *)this_gen;
+
+        this->EvasObject = EvasObject;
+
+        return video_set_display (this->player_handle, this->EvasObject);
+    }
+    dlog_print (DLOG_INFO, "DIT", "NULL module");
+    return false;
+
+}
+
+bool setVideoPlayerPool (Video this_gen, PlayerPool pool)
+{
+    if ( this_gen != NULL)
+    {
+        VideoExtends * this = (VideoExtends *)this_gen;
+
+        this->pool = pool;
+        return true;
+    }
+    dlog_print (DLOG_INFO, "DIT", "NULL module");
+    return false;
+}
+
+Audio NewAudio ()
+{
+
+    AudioExtends * this = (AudioExtends *)malloc (sizeof (AudioExtends));
+
+    this->audio.getInfo = getAudioInfo;
+    this->audio.Pause   = pauseAudio;
+    this->audio.Play    = playAudio;
+    this->audio.Stop    = stopAudio;
+    this->audio.setURI  = setAudioURI;
+    this->audio.setPool = setAudioPlayerPool;
+
+    this->uri                 = NULL;
+    this->player_handle       = NULL;
+    this->audioMetadataHandle = NULL;
+    this->pool                = NULL;
+    this->metadataLoaded      = false;
+    memset (this->metadata, 0, sizeof (this->metadata));
+
+    player_create (&this->player_handle);
+    metadata_extractor_create (&this->audioMetadataHandle);
+
+    return &this->audio;
+}
+
+void DestroyAudio (Audio this_gen)
+{
+
+    if ( this_gen != NULL)
+    {
+        AudioExtends * this = (AudioExtends *)this_gen;
+
+        if ( this->uri != NULL)
+        {
+            free (this->uri);
+        }
+
+        metadata_extractor_destroy (this->audioMetadataHandle);
+        media_metadata_clear (this->metadata, &this->metadataLoaded);
+        player_unprepare (this->player_handle);
+        player_destroy (this->player_handle);
+        free (this);
+    }
+
+    dlog_print (DLOG_INFO, "DIT", "NULL module");
+    return;
+
+}
+
+bool playAudio (Audio this_gen)
+{
+    if ( this_gen != NULL)
+    {
+        player_error_e res;
+
+        AudioExtends * this = (AudioExtends *)this_gen;
+
+        res = player_prepare (this->player_handle);
+
+        if ( res != PLAYER_ERROR_NONE && res != PLAYER_ERROR_INVALID_STATE )
+        {
+            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (res));
+        }
+        player_unset_completed_cb (this->player_handle);
+        player_set_completed_cb (this->player_handle, player_completed_callback, this->player_handle);
+        res = player_start (this->player_handle);
+
+        if ( res != PLAYER_ERROR_NONE && res != PLAYER_ERROR_INVALID_STATE )
+        {
+            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (res));
+            return false;
+        }
+        return true;
+    }
+
+    dlog_print (DLOG_INFO, "DIT", "NULL module");
+    return false;
+}
+
+bool pauseAudio (Audio this_gen)
+{
+    if ( this_gen != NULL)
+    {
+        player_error_e res;
+
+        AudioExtends * this = (AudioExtends *)this_gen;
+
+        res = player_pause (this->player_handle);
+
+        if ( res != PLAYER_ERROR_NONE && res != PLAYER_ERROR_INVALID_STATE )
+        {
+            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (res));
+            return false;
+        }
+        return true;
+    }
+    dlog_print (DLOG_INFO, "DIT", "NULL module");
+    return false;
+
+}
+
+bool stopAudio (Audio this_gen)
+{
+    if ( this_gen != NULL)
+    {
+        player_error_e res;
+
+        AudioExtends * this = (AudioExtends *)this_gen;
+
+        res = player_stop (this->player_handle);
+
+        if ( res != PLAYER_ERROR_NONE && res != PLAYER_ERROR_INVALID_STATE )
+        {
+            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (res));
+            return false;
+        }
+
+        return true;
+    }
+    dlog_print (DLOG_INFO, "DIT", "NULL module");
+    return false;
+
+}
+
+bool setAudioURI (Audio this_gen, String uri)
+{
+
+    if ( this_gen != NULL)
+    {
+        AudioExtends * this = (AudioExtends *)this_gen;
+        player_error_e res = PLAYER_ERROR_NONE;
+
+        if ( NULL == uri )
+        {
+            dlog_print (DLOG_INFO, "DIT", "NULL URI");
+            return false;
+        }
+
+        if ( NULL != this->uri )
+        {
+            free (this->uri);
+        }
+
+        this->uri = malloc (strlen (uri) + sizeof (char));
+        strcpy (this->uri, uri);
+
+        if ( player_swap_prepared (this->pool, &this->player_handle, this->uri, NULL) == false )
+        {
+            // 이전 URI 로 prepare 된 상태이면 URI 를 바꿀 수 없으므로 먼저 unprepare 한다.
+            player_unprepare (this->player_handle);
+            res = player_set_uri (this->player_handle, this->uri);
+
+            if ( res != PLAYER_ERROR_NONE )
+            {
+                dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (res));
+                return false;
+            }
+        }
+
+        media_metadata_clear (this->metadata, &this->metadataLoaded);
+        res = metadata_extractor_set_path (this->audioMetadataHandle, this->uri);
+
+        if ( res != PLAYER_ERROR_NONE )
+        {
+            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (res));
+            return false;
+        }
+
+        return true;
+    }
+    dlog_print (DLOG_INFO, "DIT", "NULL module");
+    return false;
+
+}
+
+bool setAudioPlayerPool (Audio this_gen, PlayerPool pool)
+{
+    if ( this_gen != NULL)
+    {
+        AudioExtends * this = (AudioExtends *)this_gen;
+
+        this->pool = pool;
+        return true;
+    }
+    dlog_print (DLOG_INFO, "DIT", "NULL module");
+    return false;
+}
+
+String getAudioInfo (Audio this_gen, metadata_extractor_attr_e metadataKey)
+{
+
+    if ( this_gen != NULL)
+    {
+        AudioExtends * this = (AudioExtends *)this_gen;
+
+        return media_metadata_get (this->audioMetadataHandle, this->metadata, &this->metadataLoaded, metadataKey);
+    }
+    dlog_print (DLOG_INFO, "DIT", "NULL module");
+    return NULL;
+}
+
+// audio playlist : 두 player 를 번갈아 사용한다. 재생중이 아닌 player 에 다음 곡을 미리 prepare 해 두고
+// 곡이 끝나면 completed callback 에서 바로 player_start 만 하여 곡 사이에 끊김이 없게 한다.
+// prepare / unprepare 는 callback 안에서 하지 않고 모두 worker 가 한다.
+// prepare 에 실패한 곡은 건너뛰고 다음에 재생할 곡을 구한다. 없으면 -1
+static int audio_playlist_next (AudioPlaylistExtends * this, int index)
+{
+    for (int i = 1; i <= this->count; i++)
+    {
+        int next = index + i;
+
+        if ( next >= this->count )
+        {
+            if ( this->repeat == false )
+            {
+                return -1;
+            }
+            next %= this->count;
+        }
+        if ( this->broken[next] == false )
+        {
+            return next;
+        }
+    }
+    return -1;
+}
+
+// 다음 곡으로 넘어간다. lock 을 잡고 호출해야 한다.
+static bool audio_playlist_advance (AudioPlaylistExtends * this)
+{
+    int next = audio_playlist_next (this, this->index);
+
+    if ( next < 0 )
+    {
+        this->playing      = false;
+        this->startPending = false;
+        return false;
+    }
+
+    // 끝난 player 는 다시 prepare 해야 재생할 수 있다.
+    if ( this->prepared[!this->current] == next )
+    {
+        this->prepared[this->current] = -1;
+        this->current                 = !this->current;
+    }
+    this->index = next;
+
+    if ( this->playing )
+    {
+        if ( this->prepared[this->current] == this->index && player_start (this->players[this->current]) == PLAYER_ERROR_NONE )
+        {
+            this->startPending = false;
+        }
+        else
+        {
+            this->startPending = true;
+        }
+    }
+    g_cond_broadcast (&this->cond);
+    return true;
+}
+
+static void audio_playlist_completed (void * user_data)
+{
+    AudioPlaylistExtends * this = (AudioPlaylistExtends *)user_data;
+
+    g_mutex_lock (&this->lock);
+    if ( this->playing )
+    {
+        audio_playlist_advance (this);
+    }
+    g_mutex_unlock (&this->lock);
+}
+
+static gpointer audio_playlist_run (gpointer data)
+{
+    AudioPlaylistExtends * this = (AudioPlaylistExtends *)data;
+
+    g_mutex_lock (&this->lock);
+    while (this->stop == false)
+    {
+        // 준비중에 곡이 바뀌어 다른 player 에 현재 곡이 준비되었으면 그 player 로 바꾼다.
+        if ( this->count > 0 && this->prepared[this->current] != this->index && this->prepared[!this->current] == this->index )
+        {
+            this->prepared[this->current] = -1;
+            this->current                 = !this->current;
+        }
+
+        if ( this->startPending )
+        {
+            // 재생할 수 없는 곡이면 건너뛰고 준비되었으면 시작한다.
+            if ( this->broken[this->index] )
+            {
+                audio_playlist_advance (this);
+                continue;
+            }
+            if ( this->prepared[this->current] == this->index )
+            {
+                player_error_e res = player_start (this->players[this->current]);
+
+                if ( res != PLAYER_ERROR_NONE )
+                {
+                    dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (res));
+                    this->playing = false;
+                }
+                this->startPending = false;
+                continue;
+            }
+        }
+
+        // 현재 곡, 다음 곡 순으로 준비되지 않은 player 를 찾는다.
+        int slot   = -1;
+        int target = -1;
+        int next   = (this->count > 0) ? audio_playlist_next (this, this->index) : -1;
+
+        if ( this->count > 0 && this->broken[this->index] == false && this->prepared[this->current] != this->index )
+        {
+            slot   = this->current;
+            target = this->index;
+        }
+        else if ( next >= 0 && this->prepared[!this->current] != next )
+        {
+            slot   = !this->current;
+            target = next;
+        }
+
+        if ( slot < 0 )
+        {
+            g_cond_wait (&this->cond, &this->lock);
+            continue;
+        }
+
+        String       uri     = strdup (this->uris[target]);
+        unsigned int version = this->version;
+        player_h     player  = this->players[slot];
+
+        this->prepared[slot] = -1;
+        g_mutex_unlock (&this->lock);
+
+        player_unprepare (player);
+        player_error_e ret = player_set_uri (player, uri);
+        if ( ret == PLAYER_ERROR_NONE )
+        {
+            ret = player_prepare (player);
+        }
+
+        g_mutex_lock (&this->lock);
+        if ( version != this->version )
+        {
+            // 준비하는 동안 목록이 바뀌었다.
+        }
+        else if ( ret == PLAYER_ERROR_NONE )
+        {
+            this->prepared[slot] = target;
+        }
+        else
+        {
+            dlog_print (DLOG_INFO, "DIT", "playlist prepare failed : %s : %s", uri, PlayerErrorCheck (ret));
+            this->broken[target] = true;
+        }
+        free (uri);
+    }
+    g_mutex_unlock (&this->lock);
+
+    return NULL;
+}
+
+static void audio_playlist_clear (AudioPlaylistExtends * this)
+{
+    for (int i = 0; i < this->count; i++)
+    {
+        free (this->uris[i]);
+    }
+    free (this->uris);
+    free (this->broken);
+    this->uris   = NULL;
+    this->broken = NULL;
+    this->count  = 0;
+}
+
+AudioPlaylist NewAudioPlaylist (void)
+{
+    AudioPlaylistExtends * this = (AudioPlaylistExtends *)malloc (sizeof (AudioPlaylistExtends));
+
+    this->playlist.setList   = setAudioPlaylist;
+    this->playlist.Play      = playAudioPlaylist;
+    this->playlist.Pause     = pauseAudioPlaylist;
+    this->playlist.Stop      = stopAudioPlaylist;
+    this->playlist.Next      = nextAudioPlaylist;
+    this->playlist.getIndex  = getAudioPlaylistIndex;
+    this->playlist.setRepeat = setAudioPlaylistRepeat;
+
+    this->players[0]   = NULL;
+    this->players[1]   = NULL;
+    this->prepared[0]  = -1;
+    this->prepared[1]  = -1;
+    this->current      = 0;
+    this->uris         = NULL;
+    this->broken       = NULL;
+    this->count        = 0;
+    this->index        = 0;
+    this->version      = 0;
+    this->repeat       = false;
+    this->playing      = false;
+    this->startPending = false;
+    this->thread       = NULL;
+    this->stop         = false;
+    g_mutex_init (&this->lock);
+    g_cond_init (&this->cond);
+
+    for (int i = 0; i < 2; i++)
+    {
+        player_error_e ret = player_create (&this->players[i]);
+
+        if ( ret == PLAYER_ERROR_NONE )
+        {
+            ret = player_set_completed_cb (this->players[i], audio_playlist_completed, this);
+        }
+        if ( ret != PLAYER_ERROR_NONE )
+        {
+            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (ret));
+            DestroyAudioPlaylist (&this->playlist);
+            return NULL;
+        }
+    }
+
+    this->thread = g_thread_try_new ("AudioPlaylist", audio_playlist_run, this, NULL);
+    if ( this->thread == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "can not start playlist thread");
+        DestroyAudioPlaylist (&this->playlist);
+        return NULL;
+    }
+
+    return &this->playlist;
+}
+
+void DestroyAudioPlaylist (AudioPlaylist this_gen)
+{
+    if ( this_gen != NULL)
+    {
+        AudioPlaylistExtends * this = (AudioPlaylistExtends *)this_gen;
+
+        // callback 이 더 이상 불리지 않게 한 뒤 worker 를 멈춘다.
+        for (int i = 0; i < 2; i++)
+        {
+            if ( this->players[i] != NULL)
+            {
+                player_unset_completed_cb (this->players[i]);
+            }
+        }
+
+        g_mutex_lock (&this->lock);
+        this->stop = true;
+        g_cond_broadcast (&this->cond);
+        g_mutex_unlock (&this->lock);
+
+        if ( this->thread != NULL)
+        {
+            g_thread_join (this->thread);
+        }
+
+        for (int i = 0; i < 2; i++)
+        {
+            if ( this->players[i] != NULL)
+            {
+                player_unprepare (this->players[i]);
+                player_destroy (this->players[i]);
+            }
+        }
+
+        audio_playlist_clear (this);
+        g_cond_clear (&this->cond);
+        g_mutex_clear (&this->lock);
+        free (this);
+    }
+}
+
+bool setAudioPlaylist (AudioPlaylist this_gen, String * uris, int count)
+{
+    if ( this_gen == NULL || uris == NULL || count < 0 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "AudioPlaylist / uris not valid");
+        return false;
+    }
+
+    AudioPlaylistExtends * this = (AudioPlaylistExtends *)this_gen;
+
+    for (int i = 0; i < count; i++)
+    {
+        if ( uris[i] == NULL)
+        {
+            dlog_print (DLOG_INFO, "DIT", "NULL URI");
+            return false;
+        }
+    }
+
+    g_mutex_lock (&this->lock);
+    player_stop (this->players[0]);
+    player_stop (this->players[1]);
+    audio_playlist_clear (this);
+
+    this->uris   = (String *)malloc (sizeof (String) * (count > 0 ? count : 1));
+    this->broken = (bool *)calloc (count > 0 ? count : 1, sizeof (bool));
+    for (int i = 0; i < count; i++)
+    {
+        this->uris[i] = strdup (uris[i]);
+    }
+    this->count        = count;
+    this->index        = 0;
+    this->prepared[0]  = -1;
+    this->prepared[1]  = -1;
+    this->playing      = false;
+    this->startPending = false;
+    this->version++;
+
+    // 재생 전에 첫 곡과 다음 곡을 미리 준비한다.
+    g_cond_broadcast (&this->cond);
+    g_mutex_unlock (&this->lock);
+
+    return true;
+}
+
+bool playAudioPlaylist (AudioPlaylist this_gen)
+{
+    if ( this_gen == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "NULL module");
+        return false;
+    }
+
+    AudioPlaylistExtends * this = (AudioPlaylistExtends *)this_gen;
+    bool                   ret  = true;
+
+    g_mutex_lock (&this->lock);
+    if ( this->count == 0 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "empty playlist");
+        ret = false;
+    }
+    else if ( this->playing == false )
+    {
+        this->playing = true;
+
+        if ( this->prepared[this->current] == this->index )
+        {
+            player_error_e res = player_start (this->players[this->current]);
+
+            if ( res != PLAYER_ERROR_NONE )
+            {
+                dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (res));
+                this->playing = false;
+                ret           = false;
+            }
+        }
+        else
+        {
+            // 아직 준비중이면 worker 가 준비를 마치는 대로 시작한다.
+            this->startPending = true;
+            g_cond_broadcast (&this->cond);
+        }
+    }
+    g_mutex_unlock (&this->lock);
+
+    return ret;
+}
+
+bool pauseAudioPlaylist (AudioPlaylist this_gen)
+{
+    if ( this_gen == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "NULL module");
+        return false;
+    }
+
+    AudioPlaylistExtends * this = (AudioPlaylistExtends *)this_gen;
+
+    g_mutex_lock (&this->lock);
+    player_error_e res = player_pause (this->players[this->current]);
+    this->playing      = false;
+    this->startPending = false;
+    g_mutex_unlock (&this->lock);
+
+    if ( res != PLAYER_ERROR_NONE && res != PLAYER_ERROR_INVALID_STATE )
+    {
+        dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (res));
+        return false;
+    }
+    return true;
+}
+
+bool stopAudioPlaylist (AudioPlaylist this_gen)
+{
+    if ( this_gen == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "NULL module");
+        return false;
+    }
+
+    AudioPlaylistExtends * this = (AudioPlaylistExtends *)this_gen;
+
+    g_mutex_lock (&this->lock);
+    player_error_e res = player_stop (this->players[this->current]);
+    this->playing      = false;
+    this->startPending = false;
+    g_mutex_unlock (&this->lock);
+
+    if ( res != PLAYER_ERROR_NONE && res != PLAYER_ERROR_INVALID_STATE )
+    {
+        dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (res));
+        return false;
+    }
+    return true;
+}
+
+bool nextAudioPlaylist (AudioPlaylist this_gen)
+{
+    if ( this_gen == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "NULL module");
+        return false;
+    }
+
+    AudioPlaylistExtends * this = (AudioPlaylistExtends *)this_gen;
+
+    g_mutex_lock (&this->lock);
+    bool ret = audio_playlist_next (this, this->index) >= 0;
+    if ( ret )
+    {
+        player_stop (this->players[this->current]);
+        audio_playlist_advance (this);
+    }
+    g_mutex_unlock (&this->lock);
+
+    if ( ret == false )
+    {
+        dlog_print (DLOG_INFO, "DIT", "end of playlist");
+    }
+    return ret;
+}
+
+int getAudioPlaylistIndex (AudioPlaylist this_gen)
+{
+    if ( this_gen == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "NULL module");
+        return -1;
+    }
+
+    AudioPlaylistExtends * this = (AudioPlaylistExtends *)this_gen;
+
+    g_mutex_lock (&this->lock);
+    int index = (this->count > 0) ? this->index : -1;
+    g_mutex_unlock (&this->lock);
+
+    return index;
+}
+
+bool setAudioPlaylistRepeat (AudioPlaylist this_gen, bool repeat)
+{
+    if ( this_gen == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "NULL module");
+        return false;
+    }
+
+    AudioPlaylistExtends * this = (AudioPlaylistExtends *)this_gen;
+
+    g_mutex_lock (&this->lock);
+    this->repeat = repeat;
+    g_cond_broadcast (&this->cond);
+    g_mutex_unlock (&this->lock);
+
+    return true;
+}
+
+// media info batch : worker 마다 metadata extractor 를 하나씩 만들어 파일들을 나누어 읽는다.
+typedef struct _MediaInfoContext
+{
+    String      * paths;
+    MediaInfo   * infos;
+    int           count;
+    volatile gint next;
+    volatile gint failed;
+
+} MediaInfoContext;
+
+static int media_info_int (metadata_extractor_h handle, metadata_extractor_attr_e element)
+{
+    String value = NULL;
+
+    if ( metadata_extractor_get_metadata (handle, element, &value) != METADATA_EXTRACTOR_ERROR_NONE || value == NULL)
+    {
+        return -1;
+    }
+
+    int ret = atoi (value);
+    free (value);
+    return ret;
+}
+
+static void media_info_string (metadata_extractor_h handle, metadata_extractor_attr_e element, char * buffer, size_t size)
+{
+    String value = NULL;
+
+    buffer[0] = '\0';
+    if ( metadata_extractor_get_metadata (handle, element, &value) == METADATA_EXTRACTOR_ERROR_NONE && value != NULL)
+    {
+        snprintf (buffer, size, "%s", value);
+        free (value);
+    }
+}
+
+static void media_info_read (metadata_extractor_h handle, String path, MediaInfo * info)
+{
+    memset (info, 0, sizeof (MediaInfo));
+
+    if ( path == NULL || metadata_extractor_set_path (handle, path) != METADATA_EXTRACTOR_ERROR_NONE )
+    {
+        info->duration = info->width = info->height = info->rotate = -1;
+        info->videoBitrate = info->audioBitrate = info->audioChannels = info->audioSamplerate = -1;
+        return;
+    }
+
+    info->valid           = true;
+    info->duration        = media_info_int (handle, METADATA_DURATION);
+    info->hasVideo        = media_info_int (handle, METADATA_HAS_VIDEO) > 0;
+    info->hasAudio        = media_info_int (handle, METADATA_HAS_AUDIO) > 0;
+    info->width           = media_info_int (handle, METADATA_VIDEO_WIDTH);
+    info->height          = media_info_int (handle, METADATA_VIDEO_HEIGHT);
+    info->rotate          = media_info_int (handle, METADATA_ROTATE);
+    info->videoBitrate    = media_info_int (handle, METADATA_VIDEO_BITRATE);
+    info->audioBitrate    = media_info_int (handle, METADATA_AUDIO_BITRATE);
+    info->audioChannels   = media_info_int (handle, METADATA_AUDIO_CHANNELS);
+    info->audioSamplerate = media_info_int (handle, METADATA_AUDIO_SAMPLERATE);
+    media_info_string (handle, METADATA_TITLE, info->title, sizeof (info->title));
+    media_info_string (handle, METADATA_ARTIST, info->artist, sizeof (info->artist));
+    media_info_string (handle, METADATA_ALBUM, info->album, sizeof (info->album));
+    media_info_string (handle, METADATA_GENRE, info->genre, sizeof (info->genre));
+    media_info_string (handle, METADATA_DATE, info->date, sizeof (info->date));
+}
+
+static gpointer media_info_run (gpointer data)
+{
+    MediaInfoContext   * context = (MediaInfoContext *)data;
+    metadata_extractor_h handle  = NULL;
+    int                  index;
+
+    if ( metadata_extractor_create (&handle) != METADATA_EXTRACTOR_ERROR_NONE )
+    {
+        dlog_print (DLOG_INFO, "DIT", "metadata_extractor_create failed");
+        return NULL;
+    }
+
+    while ((index = g_atomic_int_add (&context->next, 1)) < context->count)
+    {
+        media_info_read (handle, context->paths[index], &context->infos[index]);
+        if ( context->infos[index].valid == false )
+        {
+            dlog_print (DLOG_INFO, "DIT", "can not read metadata : %s", context->paths[index] ? context->paths[index] : "(null)");
+            g_atomic_int_set (&context->failed, 1);
+        }
+    }
+
+    metadata_extractor_destroy (handle);
+    return NULL;
+}
+
+bool getMediaInfoBatch (String * paths, int count, MediaInfo * infos, int threadCount)
+{
+    MediaInfoContext context;
+
+    if ( paths == NULL || infos == NULL || count < 0 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "paths / infos not valid");
+        return false;
+    }
+
+    if ( threadCount <= 0 )
+    {
+        threadCount = g_get_num_processors ();
+    }
+    if ( threadCount > count )
+    {
+        threadCount = count;
+    }
+
+    context.paths  = paths;
+    context.infos  = infos;
+    context.count  = count;
+    context.next   = 0;
+    context.failed = 0;
+
+    GThread ** threads = (GThread **)calloc (threadCount > 0 ? threadCount : 1, sizeof (GThread *));
+
+    for (int i = 1; i < threadCount; i++)
+    {
+        threads[i] = g_thread_try_new ("MediaInfo", media_info_run, &context, NULL);
+    }
+    media_info_run (&context);
+
+    for (int i = 1; i < threadCount; i++)
+    {
+        if ( threads[i] != NULL)
+        {
+            g_thread_join (threads[i]);
+        }
+    }
+    free (threads);
+
+    // extractor 를 만들지 못해 남은 항목이 있으면 실패로 표시한다.
+    for (int i = g_atomic_int_get (&context.next); i < count; i++)
+    {
+        media_info_read (NULL, NULL, &infos[i]);
+        context.failed = 1;
+    }
+
+    return context.failed == 0;
+}
+
+// media DB session : Image / ImageCache / image batch 가 함께 쓰는 media_content 연결.
+// 객체가 참조를 잡고 있는 동안 처음 사용할 때 연결하며 마지막 참조가 풀릴 때 연결을 끊는다.
+static GMutex mediaSessionLock;
+static int    mediaSessionRefs      = 0;
+static bool   mediaSessionConnected = false;
+
+static void media_session_ref (void)
+{
+    g_mutex_lock (&mediaSessionLock);
+    mediaSessionRefs++;
+    g_mutex_unlock (&mediaSessionLock);
+}
+
+static void media_session_unref (void)
+{
+    g_mutex_lock (&mediaSessionLock);
+    if ( --mediaSessionRefs == 0 && mediaSessionConnected )
+    {
+        media_content_disconnect ();
+        mediaSessionConnected = false;
+    }
+    g_mutex_unlock (&mediaSessionLock);
+}
+
+// 참조를 잡은 상태에서 호출해야 한다.
+static bool media_session_connect (void)
+{
+    media_content_error_e error = MEDIA_CONTENT_ERROR_NONE;
+
+    g_mutex_lock (&mediaSessionLock);
+    if ( mediaSessionConnected == false )
+    {
+        error = media_content_connect ();
+        mediaSessionConnected = (error == MEDIA_CONTENT_ERROR_NONE);
+    }
+    g_mutex_unlock (&mediaSessionLock);
+
+    if ( error != MEDIA_CONTENT_ERROR_NONE )
+    {
+        dlog_print (DLOG_INFO, "DIT", "%s", MediaContentErrorCheck (error));
+        return false;
+    }
+    return true;
+}
+
+Image NewImage ()
+{
+    ImageExtends * this = (ImageExtends *)malloc (sizeof (ImageExtends));
+
+    this->image.setURI     = setImageURI;
+    this->imageMetaHandle  = NULL;
+    this->image.getMediaId = getImageMediaId;
+    this->image.getDate    = getImageDate;
+    this->image.getWidth   = getImageWidth;
+    this->image.getHeight  = getImageHeight;
+    this->image.setCache   = setImageCache;
+    this->height           = -1;
+    this->width            = -1;
+    this->datetaken        = NULL;
+    this->media_id         = NULL;
+    this->cache            = NULL;
+
+    media_session_ref ();
+
+    return &this->image;
+}
+
+void DestroyImage (Image this_gen)
+{
+    if ( this_gen == NULL)
+    {
+        return;
+    }
+
+    ImageExtends * this = (ImageExtends *)this_gen;
+
+    if ( this->imageMetaHandle != NULL)
+    {
+        image_meta_destroy (this->imageMetaHandle);
+    }
+
+    if ( this->datetaken )
+    {
+        free (this->datetaken);
+    }
+
+    if ( this->media_id )
+    {
+        free (this->media_id);
+    }
+
+    media_session_unref ();
+    free (this_gen);
+}
+
+bool setImageURI (Image this_gen, String src)
+{
+    if ( this_gen != NULL && src != NULL)
+    {
+        ImageExtends * this = (ImageExtends *)this_gen;
+        ImageCacheInfo entry;
+        bool           found;
+
+        // cache 가 있으면 cache 를 거치고 없으면 batch query 를 한 path 로 사용한다.
+        if ( this->cache != NULL)
+        {
+            found = getImageCacheInfo (this->cache, src, &entry);
+        }
+        else
+        {
+            found = image_query (&src, 1, NULL, &entry) && entry.info.media_id[0] != '\0';
+        }
+
+        if ( found == false )
+        {
+            dlog_print (DLOG_INFO, "DIT", "not image");
+            return false;
+        }
+
+        free (this->media_id);
+        free (this->datetaken);
+        this->media_id  = strdup (entry.info.media_id);
+        this->datetaken = strdup (entry.info.date_taken);
+        this->width     = entry.info.width;
+        this->height    = entry.info.height;
+
+        return true;
+    }
+    dlog_print (DLOG_INFO, "DIT", "NULL module");
+    return false;
+
+}
+
+String getImageMediaId (Image this_gen)
+{
+    ImageExtends * this = (ImageExtends *)this_gen;
+
+    return this->media_id;
+}
+
+String getImageDate (Image this_gen)
+{
+    ImageExtends * this = (ImageExtends *)this_gen;
+    return this->datetaken;
+}
+
+int getImageWidth (Image this_gen)
+{
+    ImageExtends * this = (ImageExtends *)this_gen;
+    return this->width;
+}
+
+int getImageHeight (Image this_gen)
+{
+    ImageExtends * this = (ImageExtends *)this_gen;
+    return this->height;
+}
+
+bool setImageCache (Image this_gen, ImageCache cache)
+{
+    if ( this_gen == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "NULL module");
+        return false;
+    }
+
+    ImageExtends * this = (ImageExtends *)this_gen;
+
+    this->cache = cache;
+    return true;
+}
+
+// image batch : 여러 path 를 MEDIA_PATH IN (...) 조건 하나로 조회하고 결과를 path 로 입력 순서에 맞춘다.
+typedef struct _ImageQuery
+{
+    GHashTable     * index;   // path -> 입력 index + 1
+    ImageInfo      * infos;
+    ImageCacheInfo * entries; // NULL 이 아니면 infos 대신 채우며 thumbnail path 도 가져온다.
+    int              found;
+
+} ImageQuery;
+
+static ImageInfo * image_query_info (ImageQuery * query, int index)
+{
+    return (query->entries != NULL) ? &query->entries[index].info : &query->infos[index];
+}
+
+static bool image_query_item (media_info_h media, void * user_data)
+{
+    ImageQuery * query    = (ImageQuery *)user_data;
+    String       path     = NULL;
+    String       media_id = NULL;
+    String       date     = NULL;
+    String       thumb    = NULL;
+    image_meta_h meta     = NULL;
+
+    if ( media_info_get_file_path (media, &path) != MEDIA_CONTENT_ERROR_NONE || path == NULL)
+    {
+        return true;
+    }
+
+    gpointer value = g_hash_table_lookup (query->index, path);
+    free (path);
+    if ( value == NULL)
+    {
+        return true;
+    }
+
+    int         index = GPOINTER_TO_INT (value) - 1;
+    ImageInfo * info  = image_query_info (query, index);
+
+    if ( media_info_get_media_id (media, &media_id) == MEDIA_CONTENT_ERROR_NONE && media_id != NULL)
+    {
+        snprintf (info->media_id, sizeof (info->media_id), "%s", media_id);
+        free (media_id);
+    }
+
+    // image meta 는 query 결과에 포함되어 있으므로 DB 에 다시 접근하지 않는다.
+    if ( media_info_get_image (media, &meta) == MEDIA_CONTENT_ERROR_NONE )
+    {
+        image_meta_get_width (meta, &info->width);
+        image_meta_get_height (meta, &info->height);
+        if ( image_meta_get_date_taken (meta, &date) == MEDIA_CONTENT_ERROR_NONE && date != NULL)
+        {
+            snprintf (info->date_taken, sizeof (info->date_taken), "%s", date);
+            free (date);
+        }
+        image_meta_destroy (meta);
+    }
+
+    if ( query->entries != NULL && media_info_get_thumbnail_path (media, &thumb) == MEDIA_CONTENT_ERROR_NONE && thumb != NULL)
+    {
+        snprintf (query->entries[index].thumbnail, sizeof (query->entries[index].thumbnail), "%s", thumb);
+        free (thumb);
+    }
+
+    query->found++;
+    return true;
+}
+
+// SQL 문자열 안의 ' 는 '' 로 바꾼다.
+static size_t image_query_quote (String dst, String src)
+{
+    size_t len = 0;
+
+    dst[len++] = '\'';
+    for (; *src != '\0'; src++)
+    {
+        if ( *src == '\'' )
+        {
+            dst[len++] = '\'';
+        }
+        dst[len++] = *src;
+    }
+    dst[len++] = '\'';
+    return len;
+}
+
+static bool image_query_run (ImageQuery * query, String condition)
+{
+    filter_h              filter = NULL;
+    media_content_error_e ret    = media_filter_create (&filter);
+
+    if ( ret == MEDIA_CONTENT_ERROR_NONE )
+    {
+        ret = media_filter_set_condition (filter, condition, MEDIA_CONTENT_COLLATE_DEFAULT);
+    }
+    if ( ret == MEDIA_CONTENT_ERROR_NONE )
+    {
+        ret = media_info_foreach_media_from_db (filter, image_query_item, query);
+    }
+    if ( filter != NULL)
+    {
+        media_filter_destroy (filter);
+    }
+
+    if ( ret != MEDIA_CONTENT_ERROR_NONE )
+    {
+        dlog_print (DLOG_INFO, "DIT", "%s", MediaContentErrorCheck (ret));
+        return false;
+    }
+    return true;
+}
+
+static bool image_query (String * paths, int count, ImageInfo * infos, ImageCacheInfo * entries)
+{
+    ImageQuery query;
+    bool       ret = true;
+
+    query.index   = g_hash_table_new (g_str_hash, g_str_equal);
+    query.infos   = infos;
+    query.entries = entries;
+    query.found   = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        ImageInfo * info = image_query_info (&query, i);
+
+        info->media_id[0]   = '\0';
+        info->width         = -1;
+        info->height        = -1;
+        info->date_taken[0] = '\0';
+        if ( entries != NULL)
+        {
+            entries[i].thumbnail[0] = '\0';
+        }
+
+        // 같은 path 가 여러번 있으면 처음 것만 조회하고 마지막에 복사한다.
+        if ( paths[i] != NULL && g_hash_table_contains (query.index, paths[i]) == false )
+        {
+            g_hash_table_insert (query.index, paths[i], GINT_TO_POINTER (i + 1));
+        }
+    }
+
+    media_session_ref ();
+    if ( media_session_connect () == false )
+    {
+        media_session_unref ();
+        g_hash_table_destroy (query.index);
+        return false;
+    }
+
+    String condition = (String)malloc (IMAGE_QUERY_CONDITION_MAX);
+    size_t prefix    = snprintf (condition, IMAGE_QUERY_CONDITION_MAX, "%s = %d AND %s IN (", MEDIA_TYPE, MEDIA_CONTENT_TYPE_IMAGE, MEDIA_PATH);
+
+    // 조건이 너무 길어지지 않도록 IMAGE_QUERY_CONDITION_MAX 단위로 나누어 조회한다. 보통은 한번에 끝난다.
+    for (int i = 0; i < count && ret;)
+    {
+        size_t len   = prefix;
+        int    added = 0;
+
+        for (; i < count; i++)
+        {
+            if ( paths[i] == NULL || GPOINTER_TO_INT (g_hash_table_lookup (query.index, paths[i])) != i + 1 )
+            {
+                continue;
+            }
+
+            // 따옴표를 두배로 늘리는 경우까지 고려한 최대 길이
+            size_t need = strlen (paths[i]) * 2 + 4;
+            if ( len + need + 2 > IMAGE_QUERY_CONDITION_MAX )
+            {
+                if ( added == 0 )
+                {
+                    dlog_print (DLOG_INFO, "DIT", "path too long : %s", paths[i]);
+                    continue;
+                }
+                break;
+            }
+
+            if ( added > 0 )
+            {
+                condition[len++] = ',';
+            }
+            len += image_query_quote (condition + len, paths[i]);
+            added++;
+        }
+
+        if ( added > 0 )
+        {
+            condition[len++] = ')';
+            condition[len]   = '\0';
+            ret = image_query_run (&query, condition);
+        }
+    }
+
+    free (condition);
+    media_session_unref ();
+
+    for (int i = 0; i < count; i++)
+    {
+        int first = (paths[i] != NULL) ? GPOINTER_TO_INT (g_hash_table_lookup (query.index, paths[i])) - 1 : i;
+
+        if ( first != i && entries != NULL)
+        {
+            entries[i] = entries[first];
+        }
+        else if ( first != i )
+        {
+            infos[i] = infos[first];
+        }
+    }
+    g_hash_table_destroy (query.index);
+
+    dlog_print (DLOG_INFO, "DIT", "image batch : %d of %d found", query.found, count);
+    return ret;
+}
+
+bool getImageInfoBatch (String * paths, int count, ImageInfo * infos)
+{
+    if ( paths == NULL || infos == NULL || count < 0 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "paths / infos not valid");
+        return false;
+    }
+    return image_query (paths, count, infos, NULL);
+}
+
+// image cache : path + mtime + size 로 찾는 mmap 저장소 (open addressing) 와 그 앞의 LRU.
+typedef struct _ImageCacheHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t capacity; // slot 수, 2 의 거듭제곱
+    uint32_t count;
+    uint32_t reserved;
+
+} ImageCacheHeader;
+
+typedef struct _ImageCacheRecord
+{
+    uint64_t       key;      // path 의 xxHash64, 0 이면 빈 slot
+    uint32_t       check;    // mtime 부터 끝까지의 checksum, 기록 도중에 깨진 record 를 걸러낸다.
+    uint32_t       reserved;
+    int64_t        mtime;
+    int64_t        size;
+    ImageCacheInfo info;
+
+} ImageCacheRecord;
+
+typedef struct _ImageCacheNode
+{
+    String         path;
+    int64_t        mtime;
+    int64_t        size;
+    ImageCacheInfo info;
+
+} ImageCacheNode;
+
+#define IMAGE_CACHE_SLOT(map, index) ((ImageCacheRecord *)((map) + sizeof (ImageCacheHeader)) + (index))
+
+static uint64_t image_cache_key (String path)
+{
+    ChecksumState state;
+
+    checksum_init (&state, CHECKSUM_XXHASH64);
+    checksum_update (&state, path, strlen (path));
+
+    uint64_t key = checksum_final (&state);
+    return (key != 0) ? key : 1;
+}
+
+static uint32_t image_cache_check (ImageCacheRecord * record)
+{
+    ChecksumState state;
+
+    checksum_init (&state, CHECKSUM_XXHASH64);
+    checksum_update (&state, &record->mtime, sizeof (ImageCacheRecord) - offsetof (ImageCacheRecord, mtime));
+    return (uint32_t)checksum_final (&state);
+}
+
+static ImageCacheRecord * image_cache_find (char * map, uint64_t key, bool insert)
+{
+    ImageCacheHeader * header = (ImageCacheHeader *)map;
+    uint32_t           mask   = header->capacity - 1;
+
+    for (uint32_t i = (uint32_t)key & mask, n = 0; n < header->capacity; i = (i + 1) & mask, n++)
+    {
+        ImageCacheRecord * slot = IMAGE_CACHE_SLOT (map, i);
+
+        if ( slot->key == key )
+        {
+            return slot;
+        }
+        if ( slot->key == 0 )
         {
-            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (res));
-            return false;
+            return insert ? slot : NULL;
         }
-        return true;
     }
-    dlog_print (DLOG_INFO, "DIT", "NULL module");
-    return false;
-
+    return NULL;
 }
 
-bool stopAudio (Audio this_gen)
+// key 는 마지막에 기록하여 새 slot 이 기록 도중에 보이지 않게 한다.
+static void image_cache_write (char * map, ImageCacheRecord * record)
 {
-    if ( this_gen != NULL)
+    ImageCacheHeader * header = (ImageCacheHeader *)map;
+    ImageCacheRecord * slot   = image_cache_find (map, record->key, true);
+
+    if ( slot == NULL)
     {
-        player_error_e res;
+        return;
+    }
+    if ( slot->key == 0 )
+    {
+        header->count++;
+    }
 
-        AudioExtends * this = (AudioExtends *)this_gen;
+    memcpy (&slot->check, &record->check, sizeof (ImageCacheRecord) - offsetof (ImageCacheRecord, check));
+    slot->key = record->key;
+}
 
-        res = player_stop (this->player_handle);
+// 새 저장소 파일을 만들어 교체한다. keep 이면 기존 record 를 옮긴다.
+static bool image_cache_resize (ImageCacheExtends * this, uint32_t capacity, bool keep)
+{
+    size_t size = sizeof (ImageCacheHeader) + (size_t)capacity * sizeof (ImageCacheRecord);
+    String temp = (String)malloc (strlen (this->file) + 5);
 
-        if ( res != PLAYER_ERROR_NONE && res != PLAYER_ERROR_INVALID_STATE )
+    sprintf (temp, "%s.tmp", this->file);
+
+    int fd = open (temp, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if ( fd == -1 || ftruncate (fd, size) == -1 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "can not create image cache : %s : %s", temp, strerror (errno));
+        if ( fd != -1 )
         {
-            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (res));
-            return false;
+            close (fd);
+            unlink (temp);
         }
+        free (temp);
+        return false;
+    }
 
-        return true;
+    char * map = (char *)mmap (NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close (fd);
+    if ( map == MAP_FAILED )
+    {
+        dlog_print (DLOG_INFO, "DIT", "mmap failed : %s", strerror (errno));
+        unlink (temp);
+        free (temp);
+        return false;
     }
-    dlog_print (DLOG_INFO, "DIT", "NULL module");
-    return false;
 
-}
+    ImageCacheHeader * header = (ImageCacheHeader *)map;
 
-bool setAudioURI (Audio this_gen, String uri)
-{
+    memcpy (header->magic, IMAGE_CACHE_MAGIC, sizeof (header->magic));
+    header->version  = IMAGE_CACHE_VERSION;
+    header->capacity = capacity;
+    header->count    = 0;
 
-    if ( this_gen != NULL)
+    if ( this->map != NULL && keep )
     {
-        AudioExtends * this = (AudioExtends *)this_gen;
-        player_error_e res = PLAYER_ERROR_NONE;
+        uint32_t oldCapacity = ((ImageCacheHeader *)this->map)->capacity;
 
-        if ( NULL == uri )
+        for (uint32_t i = 0; i < oldCapacity; i++)
         {
-            dlog_print (DLOG_INFO, "DIT", "NULL URI");
-            return false;
-        }
+            ImageCacheRecord * slot = IMAGE_CACHE_SLOT (this->map, i);
 
-        if ( NULL != this->uri )
-        {
-            free (this->uri);
+            if ( slot->key != 0 && slot->check == image_cache_check (slot))
+            {
+                image_cache_write (map, slot);
+            }
         }
+    }
 
-        this->uri = malloc (strlen (uri) + sizeof (char));
-        strcpy (this->uri, uri);
+    rename (temp, this->file);
+    free (temp);
 
-        res = player_set_uri (this->player_handle, this->uri);
+    if ( this->map != NULL)
+    {
+        munmap (this->map, this->mapSize);
+    }
+    this->map     = map;
+    this->mapSize = size;
+    return true;
+}
 
-        if ( res != PLAYER_ERROR_NONE )
-        {
-            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (res));
-            return false;
-        }
+static bool image_cache_open (ImageCacheExtends * this)
+{
+    struct stat statbuf;
 
-        res = metadata_extractor_set_path (this->audioMetadataHandle, this->uri);
+    int fd = open (this->file, O_RDWR | O_CLOEXEC);
+    if ( fd != -1 && fstat (fd, &statbuf) == 0 && (size_t)statbuf.st_size > sizeof (ImageCacheHeader))
+    {
+        char * map = (char *)mmap (NULL, statbuf.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
 
-        if ( res != PLAYER_ERROR_NONE )
+        if ( map != MAP_FAILED )
         {
-            dlog_print (DLOG_INFO, "DIT", "%s", PlayerErrorCheck (res));
-            return false;
-        }
+            ImageCacheHeader * header = (ImageCacheHeader *)map;
+            uint32_t           capacity = header->capacity;
 
-        return true;
+            if ( memcmp (header->magic, IMAGE_CACHE_MAGIC, sizeof (header->magic)) == 0 && header->version == IMAGE_CACHE_VERSION
+                 && capacity > 0 && (capacity & (capacity - 1)) == 0
+                 && (size_t)statbuf.st_size == sizeof (ImageCacheHeader) + (size_t)capacity * sizeof (ImageCacheRecord))
+            {
+                close (fd);
+                this->map     = map;
+                this->mapSize = statbuf.st_size;
+                return true;
+            }
+            munmap (map, statbuf.st_size);
+        }
+    }
+    if ( fd != -1 )
+    {
+        close (fd);
     }
-    dlog_print (DLOG_INFO, "DIT", "NULL module");
-    return false;
 
+    // 없거나 형식이 맞지 않으면 새로 만든다.
+    return image_cache_resize (this, IMAGE_CACHE_SLOTS, false);
 }
 
-String getAudioInfo (Audio this_gen, metadata_extractor_attr_e metadataKey)
+static bool image_cache_load (ImageCacheExtends * this, String path, int64_t mtime, int64_t size, ImageCacheInfo * info)
 {
+    ImageCacheRecord   record;
+    ImageCacheRecord * slot = image_cache_find (this->map, image_cache_key (path), false);
 
-    if ( this_gen != NULL)
+    if ( slot == NULL)
     {
-        AudioExtends * this = (AudioExtends *)this_gen;
-        metadata_extractor_error_e error_value;
-
-        String res = NULL;
-        error_value = metadata_extractor_get_metadata (this->audioMetadataHandle, metadataKey, &res);
+        return false;
+    }
 
-        return res;
+    memcpy (&record, slot, sizeof (ImageCacheRecord));
+    if ( record.check != image_cache_check (&record) || record.mtime != mtime || record.size != size )
+    {
+        return false;
     }
-    dlog_print (DLOG_INFO, "DIT", "NULL module");
-    return NULL;
+    *info = record.info;
+    return true;
 }
 
-Image NewImage ()
+static void image_cache_store (ImageCacheExtends * this, String path, int64_t mtime, int64_t size, ImageCacheInfo * info)
 {
-    ImageExtends * this = (ImageExtends *)malloc (sizeof (ImageExtends));
+    ImageCacheRecord record;
+    uint32_t         capacity = ((ImageCacheHeader *)this->map)->capacity;
 
-    this->image.setURI     = setImageURI;
-    this->imageMetaHandle  = NULL;
-    this->image.getMediaId = getImageMediaId;
-    this->image.getDate    = getImageDate;
-    this->image.getWidth   = getImageWidth;
-    this->image.getHeight  = getImageHeight;
-    this->height           = -1;
-    this->width            = -1;
-    this->datetaken        = NULL;
-    this->media_id         = NULL;
+    // 3/4 이상 차면 두배로 늘린다. 최대 크기를 넘으면 비우고 다시 시작한다.
+    if (((ImageCacheHeader *)this->map)->count + 1 > capacity / 4 * 3 )
+    {
+        bool keep = (capacity * 2 <= IMAGE_CACHE_MAX_SLOTS);
 
-    return &this->image;
+        if ( image_cache_resize (this, keep ? capacity * 2 : IMAGE_CACHE_SLOTS, keep) == false )
+        {
+            return;
+        }
+    }
+
+    memset (&record, 0, sizeof (ImageCacheRecord));
+    record.key   = image_cache_key (path);
+    record.mtime = mtime;
+    record.size  = size;
+    record.info  = *info;
+    record.check = image_cache_check (&record);
+
+    image_cache_write (this->map, &record);
 }
 
-void DestroyImage (Image this_gen)
+static ImageCacheNode * image_cache_lru_get (ImageCacheExtends * this, String path, int64_t mtime, int64_t size)
 {
-    if ( this_gen )
+    GList * link = (GList *)g_hash_table_lookup (this->index, path);
+
+    if ( link == NULL)
     {
-        return;
+        return NULL;
     }
 
-    ImageExtends * this = (ImageExtends *)this_gen;
+    ImageCacheNode * node = (ImageCacheNode *)link->data;
+    if ( node->mtime != mtime || node->size != size )
+    {
+        return NULL;
+    }
 
-    if ( this->imageMetaHandle != NULL)
+    g_queue_unlink (&this->lru, link);
+    g_queue_push_head_link (&this->lru, link);
+    return node;
+}
+
+static void image_cache_lru_put (ImageCacheExtends * this, String path, int64_t mtime, int64_t size, ImageCacheInfo * info)
+{
+    GList          * link = (GList *)g_hash_table_lookup (this->index, path);
+    ImageCacheNode * node;
+
+    if ( link != NULL)
     {
-        image_meta_destroy (this->imageMetaHandle);
+        g_queue_unlink (&this->lru, link);
+        g_queue_push_head_link (&this->lru, link);
+        node = (ImageCacheNode *)link->data;
+    }
+    else
+    {
+        node       = (ImageCacheNode *)malloc (sizeof (ImageCacheNode));
+        node->path = strdup (path);
+        g_queue_push_head (&this->lru, node);
+        g_hash_table_insert (this->index, node->path, this->lru.head);
     }
 
-    if ( this->datetaken )
+    node->mtime = mtime;
+    node->size  = size;
+    node->info  = *info;
+
+    if ((int)this->lru.length > this->capacity )
     {
-        free (this->datetaken);
+        link = this->lru.tail;
+        node = (ImageCacheNode *)link->data;
+
+        g_hash_table_remove (this->index, node->path);
+        g_queue_delete_link (&this->lru, link);
+        free (node->path);
+        free (node);
     }
+}
 
-    if ( this->media_id )
+// LRU -> 저장소 순으로 찾고 저장소에서 찾으면 LRU 에 올린다. lock 을 잡고 호출해야 한다.
+static bool image_cache_lookup (ImageCacheExtends * this, String path, int64_t mtime, int64_t size, ImageCacheInfo * info)
+{
+    ImageCacheNode * node = image_cache_lru_get (this, path, mtime, size);
+
+    if ( node != NULL)
     {
-        free (this->media_id);
+        *info = node->info;
+        return true;
     }
+    if ( image_cache_load (this, path, mtime, size, info))
+    {
+        image_cache_lru_put (this, path, mtime, size, info);
+        return true;
+    }
+    return false;
+}
 
-    free (this_gen);
+static bool image_cache_found (ImageCacheInfo * info)
+{
+    return info->info.media_id[0] != '\0';
 }
 
-bool gallery_media_item_cbx (media_info_h media, void * user_data)
+static gpointer image_cache_prefetch_run (gpointer data)
 {
-    media_info_h new_media = NULL;
-    media_info_clone (&new_media, media);
+    ImageCacheExtends * this = (ImageCacheExtends *)data;
+    String              paths[IMAGE_CACHE_PREFETCH_BATCH];
+    int64_t             mtimes[IMAGE_CACHE_PREFETCH_BATCH];
+    int64_t             sizes[IMAGE_CACHE_PREFETCH_BATCH];
+    ImageCacheInfo      entries[IMAGE_CACHE_PREFETCH_BATCH];
+    struct stat         statbuf;
+
+    g_mutex_lock (&this->lock);
+    while (true)
+    {
+        while (this->stop == false && g_queue_is_empty (&this->pending))
+        {
+            g_cond_wait (&this->cond, &this->lock);
+        }
+        if ( this->stop )
+        {
+            break;
+        }
 
-    GList ** list = (GList **)user_data;
-    *list = g_list_append (*list, new_media);
+        int count = 0;
+        while (count < IMAGE_CACHE_PREFETCH_BATCH && g_queue_is_empty (&this->pending) == false)
+        {
+            paths[count++] = (String)g_queue_pop_head (&this->pending);
+        }
+        g_mutex_unlock (&this->lock);
 
-    return false;
+        // 이미 cache 에 있는 path 는 LRU 에만 올리고 나머지를 한번의 query 로 가져온다.
+        int misses = 0;
+        for (int i = 0; i < count; i++)
+        {
+            bool hit = true;
+
+            if ( stat (paths[i], &statbuf) == 0 )
+            {
+                g_mutex_lock (&this->lock);
+                hit = image_cache_lookup (this, paths[i], stat_mtime (&statbuf), statbuf.st_size, &entries[0]);
+                g_mutex_unlock (&this->lock);
+            }
+
+            if ( hit )
+            {
+                free (paths[i]);
+                continue;
+            }
+            paths[misses]  = paths[i];
+            mtimes[misses] = stat_mtime (&statbuf);
+            sizes[misses]  = statbuf.st_size;
+            misses++;
+        }
+
+        if ( misses > 0 )
+        {
+            image_query (paths, misses, NULL, entries);
+        }
+
+        g_mutex_lock (&this->lock);
+        for (int i = 0; i < misses; i++)
+        {
+            if ( image_cache_found (&entries[i]))
+            {
+                image_cache_store (this, paths[i], mtimes[i], sizes[i], &entries[i]);
+                image_cache_lru_put (this, paths[i], mtimes[i], sizes[i], &entries[i]);
+            }
+            free (paths[i]);
+        }
+    }
+    g_mutex_unlock (&this->lock);
+
+    return NULL;
 }
 
-bool setImageURI (Image this_gen, String src)
+ImageCache NewImageCache (String file, int memoryEntries)
 {
-    if ( this_gen != NULL)
+    if ( file == NULL)
     {
-        GList * all_item_list = NULL; // Include glib.h
-        media_info_h              media_handle = NULL;
-        media_content_type_e      media_type   = 0;
-        char                      buf[1024]    = {'\0'};
-        media_content_error_e     ret          = MEDIA_CONTENT_ERROR_NONE;
-        filter_h                  filter       = NULL;
-        media_content_collation_e collate_type = MEDIA_CONTENT_COLLATE_NOCASE;
-        media_content_order_e     order_type   = MEDIA_CONTENT_ORDER_DESC;
+        dlog_print (DLOG_INFO, "DIT", "cache file path not valid");
+        return NULL;
+    }
 
-        ImageExtends * this = (ImageExtends *)this_gen;
+    ImageCacheExtends * this = (ImageCacheExtends *)malloc (sizeof (ImageCacheExtends));
+
+    this->cache.Get      = getImageCacheInfo;
+    this->cache.Prefetch = prefetchImageCache;
 
-        media_content_connect ();
+    this->file     = strdup (file);
+    this->map      = NULL;
+    this->mapSize  = 0;
+    this->capacity = (memoryEntries > 0) ? memoryEntries : IMAGE_CACHE_MEMORY;
+    this->index    = g_hash_table_new (g_str_hash, g_str_equal);
+    this->thread   = NULL;
+    this->stop     = false;
+    g_queue_init (&this->lru);
+    g_queue_init (&this->pending);
+    g_mutex_init (&this->lock);
+    g_cond_init (&this->cond);
 
-        media_filter_create (&filter);
+    media_session_ref ();
 
-        String filterpath = calloc (strlen (src) + 3, sizeof (char));
+    if ( image_cache_open (this) == false )
+    {
+        DestroyImageCache (&this->cache);
+        return NULL;
+    }
+
+    return &this->cache;
+}
 
-        snprintf(filterpath, strlen (src) + 3, "'%s'", src);
-        // Set the condition
-        snprintf(buf, 1024, "%s = %d AND %s = %s", MEDIA_TYPE, MEDIA_CONTENT_TYPE_IMAGE, MEDIA_PATH, filterpath);
+void DestroyImageCache (ImageCache this_gen)
+{
+    if ( this_gen != NULL)
+    {
+        ImageCacheExtends * this = (ImageCacheExtends *)this_gen;
+        ImageCacheNode    * node;
+        String              path;
 
-        free (filterpath);
-        ret = media_filter_set_condition (filter, buf, collate_type);
+        g_mutex_lock (&this->lock);
+        this->stop = true;
+        g_cond_broadcast (&this->cond);
+        g_mutex_unlock (&this->lock);
 
-        if ( ret != MEDIA_CONTENT_ERROR_NONE )
+        if ( this->thread != NULL)
         {
-            media_filter_destroy (filter);
-            dlog_print (DLOG_INFO, "DIT", MediaContentErrorCheck (ret));
-            return false;
+            g_thread_join (this->thread);
         }
-        ret = media_filter_set_order (filter, order_type, MEDIA_DISPLAY_NAME, collate_type);
 
-        if ( ret != MEDIA_CONTENT_ERROR_NONE )
+        while ((path = (String)g_queue_pop_head (&this->pending)) != NULL)
         {
-
-            media_filter_destroy (filter);
-            dlog_print (DLOG_INFO, "DIT", MediaContentErrorCheck (ret));
-            return false;
+            free (path);
         }
-
-        ret = media_info_foreach_media_from_db (filter, gallery_media_item_cbx, &all_item_list);
-
-        if ( ret != MEDIA_CONTENT_ERROR_NONE )
+        while ((node = (ImageCacheNode *)g_queue_pop_head (&this->lru)) != NULL)
         {
-            dlog_print (DLOG_INFO, "DIT", MediaContentErrorCheck (ret));
-            return false;
+            free (node->path);
+            free (node);
         }
-        media_handle = (media_info_h)g_list_nth_data (all_item_list, 0);
+        g_hash_table_destroy (this->index);
 
-        ret = media_info_get_media_id (media_handle, &this->media_id);
-        if ( ret != MEDIA_CONTENT_ERROR_NONE )
+        if ( this->map != NULL)
         {
-            g_list_free_full (all_item_list, deletemediaresult);
-            dlog_print (DLOG_INFO, "DIT", MediaContentErrorCheck (ret));
-            return false;
+            munmap (this->map, this->mapSize);
         }
-        if ( media_type == MEDIA_CONTENT_TYPE_IMAGE )
-        {
 
-            ret = media_info_get_image (media_handle, &this->imageMetaHandle);
+        media_session_unref ();
 
-            if ( ret != MEDIA_CONTENT_ERROR_NONE )
-            {
-                g_list_free_full (all_item_list, deletemediaresult);
-                dlog_print (DLOG_INFO, "DIT", MediaContentErrorCheck (ret));
-                return false;
-            }
+        g_cond_clear (&this->cond);
+        g_mutex_clear (&this->lock);
+        free (this->file);
+        free (this);
+    }
+}
 
-            ret = image_meta_get_width (this->imageMetaHandle, &this->width);
+bool getImageCacheInfo (ImageCache this_gen, String path, ImageCacheInfo * info)
+{
+    struct stat statbuf;
 
-            if ( ret != MEDIA_CONTENT_ERROR_NONE )
-            {
-                g_list_free_full (all_item_list, deletemediaresult);
-                dlog_print (DLOG_INFO, "DIT", MediaContentErrorCheck (ret));
-                return false;
-            }
+    if ( this_gen == NULL || path == NULL || info == NULL)
+    {
+        dlog_print (DLOG_INFO, "DIT", "ImageCache / path / info not valid");
+        return false;
+    }
 
-            ret = image_meta_get_height (this->imageMetaHandle, &this->height);
-            if ( ret != MEDIA_CONTENT_ERROR_NONE )
-            {
-                g_list_free_full (all_item_list, deletemediaresult);
-                dlog_print (DLOG_INFO, "DIT", MediaContentErrorCheck (ret));
-                return false;
-            }
+    ImageCacheExtends * this = (ImageCacheExtends *)this_gen;
 
-            if ( this->datetaken )
-            {
-                free (this->datetaken);
-            }
+    if ( stat (path, &statbuf) == -1 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "source file doesn't exist");
+        return false;
+    }
 
-            ret = image_meta_get_date_taken (this->imageMetaHandle, &this->datetaken);
-            if ( ret != MEDIA_CONTENT_ERROR_NONE )
-            {
-                g_list_free_full (all_item_list, deletemediaresult);
-                dlog_print (DLOG_INFO, "DIT", MediaContentErrorCheck (ret));
-                return false;
-            }
+    int64_t mtime = stat_mtime (&statbuf);
+    int64_t size  = statbuf.st_size;
 
-            media_content_disconnect ();
+    g_mutex_lock (&this->lock);
+    bool hit = image_cache_lookup (this, path, mtime, size, info);
+    g_mutex_unlock (&this->lock);
 
-            return true;
-        }
-        else
-        {
-            dlog_print (DLOG_INFO, "DIT", "not image");
-            return false;
-        }
+    if ( hit )
+    {
+        return true;
+    }
 
+    // DB 조회는 lock 밖에서 하여 다른 thread 의 cache 조회를 막지 않는다.
+    if ( image_query (&path, 1, NULL, info) == false || image_cache_found (info) == false )
+    {
+        dlog_print (DLOG_INFO, "DIT", "image not in media DB : %s", path);
+        return false;
     }
-    dlog_print (DLOG_INFO, "DIT", "NULL module");
-    return false;
 
+    g_mutex_lock (&this->lock);
+    image_cache_store (this, path, mtime, size, info);
+    image_cache_lru_put (this, path, mtime, size, info);
+    g_mutex_unlock (&this->lock);
+
+    return true;
 }
 
-String getImageMediaId (Image this_gen)
+bool prefetchImageCache (ImageCache this_gen, String * paths, int count)
 {
-    ImageExtends * this = (ImageExtends *)this_gen;
+    if ( this_gen == NULL || paths == NULL || count < 0 )
+    {
+        dlog_print (DLOG_INFO, "DIT", "ImageCache / paths not valid");
+        return false;
+    }
 
-    return this->media_id;
-}
+    ImageCacheExtends * this = (ImageCacheExtends *)this_gen;
 
-String getImageDate (Image this_gen)
-{
-    ImageExtends * this = (ImageExtends *)this_gen;
-    return this->datetaken;
-}
+    g_mutex_lock (&this->lock);
+    if ( this->thread == NULL)
+    {
+        this->thread = g_thread_try_new ("ImageCache", image_cache_prefetch_run, this, NULL);
+        if ( this->thread == NULL)
+        {
+            g_mutex_unlock (&this->lock);
+            dlog_print (DLOG_INFO, "DIT", "can not start prefetch thread");
+            return false;
+        }
+    }
 
-int getImageWidth (Image this_gen)
-{
-    ImageExtends * this = (ImageExtends *)this_gen;
-    return this->width;
-}
+    for (int i = 0; i < count; i++)
+    {
+        if ( paths[i] != NULL)
+        {
+            g_queue_push_tail (&this->pending, strdup (paths[i]));
+        }
+    }
+    g_cond_signal (&this->cond);
+    g_mutex_unlock (&this->lock);
 
-int getImageHeight (Image this_gen)
-{
-    ImageExtends * this = (ImageExtends *)this_gen;
-    return this->height;
+    return true;
 }
 
 static void player_completed_callback (void * user_data)